@@ -1,22 +1,48 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "arena.h"
 #include "chao.h"
 #include "fila.h"
 #include "formas.h"
 #include "sobreposicao.h"
+#include "sobreposicaoLote.h"
 
 #define PI 3.14159265358979323846
 
+// abaixo disso por thread, criar threads custa mais que avaliar os pares
+#define PARES_MINIMOS_POR_THREAD 512
+
+// pares entregues por vez a sobrepoePares
+#define PARES_POR_LOTE 1024
+
 struct Arena_t {
     double largura;
     double altura;
     Queue filaDeFormas; 
+    int threadsCalc;    // threads usadas para avaliar os pares no calc
 };
 
+// resultado da avaliação de um par (I, J): só depende das duas formas
+typedef struct {
+    bool sobrepoe;
+    double area_I;
+    double area_J;
+} VeredictoPar;
+
+// faixa de pares [inicio, fim) avaliada por uma thread
+typedef struct {
+    Forma *formas;              // formas na ordem da fila: par p = (2p, 2p+1)
+    VeredictoPar *veredictos;
+    int inicio;
+    int fim;
+} FaixaPares;
+
 /*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
 
 Arena criaArena(double largura, double altura) {
@@ -35,6 +61,7 @@ Arena criaArena(double largura, double altura) {
 
     a->largura = largura;
     a->altura = altura;
+    a->threadsCalc = 1;
 
     return a;
 }
@@ -55,6 +82,22 @@ void destroiArena(Arena a) {
     free(arena);
 }
 
+static void descartaFormaFila(Item i, void *auxData) {
+    (void) auxData;
+    descartaForma((Forma) i);
+}
+
+void descartaArena(Arena a) {
+    if (a == NULL) {
+        return;
+    }
+
+    struct Arena_t *arena = (struct Arena_t*) a;
+    iteraFila(arena->filaDeFormas, descartaFormaFila, NULL);
+    destroiFila(arena->filaDeFormas);
+    free(arena);
+}
+
 /*________________________________ FUNÇÕES DE MANIPULAÇÃO DE FORMAS ________________________________*/
 
 void insereFormaArena(Arena a, Forma f) {
@@ -66,6 +109,15 @@ void insereFormaArena(Arena a, Forma f) {
     enfileira(arena->filaDeFormas, f);
 }
 
+void insereFormasArena(Arena a, Forma *formas, int n) {
+    if (a == NULL || formas == NULL) {
+        return;
+    }
+
+    struct Arena_t *arena = (struct Arena_t*) a;
+    enfileiraVetor(arena->filaDeFormas, formas, n);
+}
+
 Forma removeFormaArena(Arena a) {
     if (a == NULL) {
         return NULL;
@@ -85,17 +137,7 @@ void iteraFormasArena(const Arena a, void (*executa)(Forma f, void *auxData), vo
     }
 
     struct Arena_t *arena = (struct Arena_t*) a;
-
-    int tamanhoOriginal = getTamanhoFila(arena->filaDeFormas);
-    if (tamanhoOriginal == 0) {
-        return;
-    }
-
-    for (int i = 0; i < tamanhoOriginal; i++) {
-        Forma f = desenfileira(arena->filaDeFormas);
-        executa(f, auxData);
-        enfileira(arena->filaDeFormas, f);
-    }
+    iteraFila(arena->filaDeFormas, executa, auxData);
 }
 
 /*________________________________ FUNÇÃO DE CLONAGEM COM CORES INVERTIDAS ________________________________*/
@@ -104,19 +146,10 @@ static Forma clonarFormaInvertida(Forma f1) {
     if (f1 == NULL) return NULL;
 
     TipoForma tipo = getFormaTipo(f1);
-    
-    char corBorda_original[64];
-    char corPreench_original[64];
-    
-    strncpy(corBorda_original, getFormaCorBorda(f1), 63);
-    corBorda_original[63] = '\0';
-    
-    strncpy(corPreench_original, getFormaCorPreenchimento(f1), 63);
-    corPreench_original[63] = '\0';
 
-    char novaCorBorda[64], novaCorPreench[64];
-    strcpy(novaCorBorda, corPreench_original);
-    strcpy(novaCorPreench, corBorda_original);
+    //cores invertidas: os nomes vêm direto da tabela de cores, sem cópia
+    char *novaCorBorda = getFormaCorPreenchimento(f1);
+    char *novaCorPreench = getFormaCorBorda(f1);
 
     int novoId = getFormaId(f1) + 100000;
     void *dados = NULL;
@@ -177,102 +210,143 @@ static Forma clonarFormaInvertida(Forma f1) {
 
 /*________________________________ PROCESSAMENTO DE INTERAÇÕES ________________________________*/
 
-void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue anotacoes_svg,
-                              FILE *arquivo_txt, int *formas_clonadas, int *formas_esmagadas, void *repo) {
-    if (a == NULL || chao == NULL) {
-        printf("ERRO: Arena ou chão nulos!\n");
-        return;
-    }
+// avalia os pares da faixa: leitura pura das formas, sem tocar em chão,
+// relatório ou alocador, então faixas diferentes podem rodar em paralelo.
+// A sobreposição sai em lotes agrupados por tipo (sobreposicaoLote.h)
+static void avaliaFaixaPares(FaixaPares *faixa) {
+    bool sobrepoem[PARES_POR_LOTE];
+
+    for (int p = faixa->inicio; p < faixa->fim; p++) {
+        int k = (p - faixa->inicio) % PARES_POR_LOTE;
+        if (k == 0) {
+            int restantes = faixa->fim - p;
+            sobrepoePares(&faixa->formas[2 * p],
+                          (restantes < PARES_POR_LOTE) ? restantes : PARES_POR_LOTE, sobrepoem);
+        }
 
-    struct Arena_t *arena = (struct Arena_t*) a;
-    (void)repo;
+        Forma forma_I = faixa->formas[2 * p];
+        Forma forma_J = faixa->formas[2 * p + 1];
+        VeredictoPar *v = &faixa->veredictos[p];
+
+        v->sobrepoe = sobrepoem[k];
+        if (v->sobrepoe) {
+            v->area_I = getFormaArea(forma_I);
+            v->area_J = getFormaArea(forma_J);
+        } else {
+            v->area_I = 0.0;
+            v->area_J = 0.0;
+        }
+    }
+}
 
-    double area_esmagada_round = 0.0;
-    int total_formas_inicial = getTamanhoFila(arena->filaDeFormas);
+static void *threadAvaliaPares(void *arg) {
+    avaliaFaixaPares((FaixaPares*) arg);
+    return NULL;
+}
 
-    if (arquivo_txt) {
-        fprintf(arquivo_txt, "\n=== PROCESSAMENTO DA ARENA ===\n");
-        fprintf(arquivo_txt, "Total de formas: %d\n\n", total_formas_inicial);
+// preenche os veredictos de todos os pares, dividindo-os em faixas contíguas
+// entre até 'numThreads' threads (a última faixa roda na thread chamadora)
+static void avaliaPares(Forma *formas, VeredictoPar *veredictos, int numPares, int numThreads) {
+    int maxThreads = numPares / PARES_MINIMOS_POR_THREAD;
+    if (numThreads > maxThreads) numThreads = maxThreads;
+    if (numThreads < 1) numThreads = 1;
+
+    FaixaPares *faixas = (FaixaPares*) malloc(numThreads * sizeof(FaixaPares));
+    pthread_t *threads = (pthread_t*) malloc(numThreads * sizeof(pthread_t));
+    bool *criada = (bool*) calloc(numThreads, sizeof(bool));
+    if (faixas == NULL || threads == NULL || criada == NULL) {
+        printf("ERRO: Falha ao alocar memória para o calc paralelo.\n");
+        exit(1);
     }
 
-    //loop principal: processa pares adjacentes (I, J)
-    while (getTamanhoFila(arena->filaDeFormas) >= 2) {
-        Forma forma_I = desenfileira(arena->filaDeFormas);
-        Forma forma_J = desenfileira(arena->filaDeFormas);
+    for (int t = 0; t < numThreads; t++) {
+        faixas[t].formas = formas;
+        faixas[t].veredictos = veredictos;
+        faixas[t].inicio = (int) ((long long) numPares * t / numThreads);
+        faixas[t].fim = (int) ((long long) numPares * (t + 1) / numThreads);
+    }
 
-        if (forma_I == NULL || forma_J == NULL) {
-            break;
+    for (int t = 0; t < numThreads - 1; t++) {
+        criada[t] = (pthread_create(&threads[t], NULL, threadAvaliaPares, &faixas[t]) == 0);
+        if (!criada[t]) {
+            avaliaFaixaPares(&faixas[t]);   //sem thread: avalia aqui mesmo
         }
+    }
+    avaliaFaixaPares(&faixas[numThreads - 1]);
 
-//verificacao de sobreposicao
-        bool sobrepoe = false;
-        TipoForma tipo_I = getFormaTipo(forma_I);
-        TipoForma tipo_J = getFormaTipo(forma_J);
-
-        // Usar as funções do módulo sobreposicao.h
-        if (tipo_I == TIPO_CIRCULO && tipo_J == TIPO_CIRCULO) {
-            sobrepoe = sobreposicaoCirculoCirculo(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
-
-        } else if (tipo_I == TIPO_CIRCULO && tipo_J == TIPO_RETANGULO) {
-            sobrepoe = sobreposicaoCirculoRetangulo(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
-
-        } else if (tipo_I == TIPO_RETANGULO && tipo_J == TIPO_CIRCULO) {
-            sobrepoe = sobreposicaoCirculoRetangulo(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
-
-        } else if (tipo_I == TIPO_RETANGULO && tipo_J == TIPO_RETANGULO) {
-            sobrepoe = sobreposicaoRetanguloRetangulo(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
-
-        } else if (tipo_I == TIPO_CIRCULO && tipo_J == TIPO_LINHA) {
-            sobrepoe = sobreposicaoCirculoLinha(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
-
-        } else if (tipo_I == TIPO_LINHA && tipo_J == TIPO_CIRCULO) {
-            sobrepoe = sobreposicaoCirculoLinha(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
-
-        } else if (tipo_I == TIPO_CIRCULO && tipo_J == TIPO_TEXTO) {
-            sobrepoe = sobreposicaoCirculoTexto(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
-
-        } else if (tipo_I == TIPO_TEXTO && tipo_J == TIPO_CIRCULO) {
-            sobrepoe = sobreposicaoCirculoTexto(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
-
-        } else if (tipo_I == TIPO_RETANGULO && tipo_J == TIPO_LINHA) {
-            sobrepoe = sobreposicaoRetanguloLinha(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
+    for (int t = 0; t < numThreads - 1; t++) {
+        if (criada[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
 
-        } else if (tipo_I == TIPO_LINHA && tipo_J == TIPO_RETANGULO) {
-            sobrepoe = sobreposicaoRetanguloLinha(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
+    free(criada);
+    free(threads);
+    free(faixas);
+}
 
-        } else if (tipo_I == TIPO_RETANGULO && tipo_J == TIPO_TEXTO) {
-            sobrepoe = sobreposicaoRetanguloTexto(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
+void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue anotacoes_svg,
+                              RelatorioTxt relatorio, int *formas_clonadas, int *formas_esmagadas, void *repo) {
+    if (a == NULL || chao == NULL) {
+        printf("ERRO: Arena ou chão nulos!\n");
+        return;
+    }
 
-        } else if (tipo_I == TIPO_TEXTO && tipo_J == TIPO_RETANGULO) {
-            sobrepoe = sobreposicaoRetanguloTexto(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
+    struct Arena_t *arena = (struct Arena_t*) a;
+    (void)repo;
 
-        } else if (tipo_I == TIPO_LINHA && tipo_J == TIPO_LINHA) {
-            sobrepoe = sobreposicaoLinhaLinha(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
+    double area_esmagada_round = 0.0;
+    //estilo dos asteriscos, criado uma vez e compartilhado por todos eles
+    Estilo estilo_asterisco = NULL;
+    int total_formas_inicial = getTamanhoFila(arena->filaDeFormas);
 
-        } else if (tipo_I == TIPO_LINHA && tipo_J == TIPO_TEXTO) {
-            sobrepoe = sobreposicaoLinhaTexto(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
+    //nível do relatório testado uma vez, antes de qualquer formatação
+    bool relata_comandos = getNivelRelatorioTxt(relatorio) >= RELATORIO_COMANDOS;
+    bool relata_detalhes = getNivelRelatorioTxt(relatorio) >= RELATORIO_COMPLETO;
 
-        } else if (tipo_I == TIPO_TEXTO && tipo_J == TIPO_LINHA) {
-            sobrepoe = sobreposicaoLinhaTexto(getFormaAssoc(forma_J), getFormaAssoc(forma_I));
+    if (relata_comandos) {
+        escreveRelatorio(relatorio, "\n=== PROCESSAMENTO DA ARENA ===\n");
+        escreveRelatorio(relatorio, "Total de formas: %d\n\n", total_formas_inicial);
+    }
 
-        } else if (tipo_I == TIPO_TEXTO && tipo_J == TIPO_TEXTO) {
-            sobrepoe = sobreposicaoTextoTexto(getFormaAssoc(forma_I), getFormaAssoc(forma_J));
+    //os pares (I, J) são disjuntos: primeiro todos são avaliados (sobreposição
+    //e áreas, possivelmente em paralelo), depois os efeitos são aplicados em
+    //sequência, na ordem da fila, para manter chão e relatório idênticos
+    Forma *formas = NULL;
+    VeredictoPar *veredictos = NULL;
+    int numPares = total_formas_inicial / 2;
+
+    if (total_formas_inicial > 0) {
+        formas = (Forma*) malloc(total_formas_inicial * sizeof(Forma));
+        veredictos = (VeredictoPar*) malloc((numPares > 0 ? numPares : 1) * sizeof(VeredictoPar));
+        if (formas == NULL || veredictos == NULL) {
+            printf("ERRO: Falha ao alocar memória para o calc.\n");
+            exit(1);
         }
+        desenfileiraVetor(arena->filaDeFormas, formas, total_formas_inicial);
+        avaliaPares(formas, veredictos, numPares, arena->threadsCalc);
+    }
+
+    //loop principal: aplica os pares adjacentes (I, J) em ordem
+    for (int p = 0; p < numPares; p++) {
+        Forma forma_I = formas[2 * p];
+        Forma forma_J = formas[2 * p + 1];
 
-        if (sobrepoe) {
+        // sobreposição já avaliada em avaliaPares (despacho por tabela de tipos, sobreposicao.h)
+        if (veredictos[p].sobrepoe) {
 
-            double area_I = getFormaArea(forma_I);
-            double area_J = getFormaArea(forma_J);
+            double area_I = veredictos[p].area_I;
+            double area_J = veredictos[p].area_J;
 
-            if (arquivo_txt) {
-                fprintf(arquivo_txt, "Forma %d (I) vs Forma %d (J). HOUVE SOBREPOSIÇÃO.\n",
+            if (relata_detalhes) {
+                escreveRelatorio(relatorio, "Forma %d (I) vs Forma %d (J). HOUVE SOBREPOSIÇÃO.\n",
                         getFormaId(forma_I), getFormaId(forma_J));
             }
 
             //========== REGRA 1: área(I) < área(J) ==========
             if (area_I < area_J) {
-                if (arquivo_txt) {
-                    fprintf(arquivo_txt, "<<<-- I < J -->>> *Forma %d (área %.2f) ESMAGADA por forma %d (área %.2f).\n",
+                if (relata_detalhes) {
+                    escreveRelatorio(relatorio, "<<<-- I < J -->>> *Forma %d (área %.2f) ESMAGADA por forma %d (área %.2f).\n",
                             getFormaId(forma_I), area_I, getFormaId(forma_J), area_J);
                 }
 
@@ -281,11 +355,12 @@ void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue
                     double x_esmagada = getFormaX(forma_I);
                     double y_esmagada = getFormaY(forma_I);
                     
-                    Estilo estilo_asterisco = criarEstilo("sans-serif", "bold", "30px");
+                    if (estilo_asterisco == NULL) {
+                        estilo_asterisco = criarEstilo("sans-serif", "bold", "30px");
+                    }
                     Texto asterisco = criarTexto(-5000 - getFormaId(forma_I), 
                                                  x_esmagada, y_esmagada, 
                                                  "red", "red", 'm', "*", estilo_asterisco);
-                    destroiEstilo(estilo_asterisco);
                     
                     Forma forma_asterisco = criaForma(-5000 - getFormaId(forma_I), TIPO_TEXTO, asterisco);
                     enfileira(anotacoes_svg, forma_asterisco);
@@ -303,17 +378,13 @@ void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue
             
             //========== REGRA 2: área(I) >= área(J) ==========
             else {
-                if (arquivo_txt) {
-                    fprintf(arquivo_txt, "<<<-- I >= J -->>> Forma %d (área %.2f) modifica forma %d (área %.2f).\n",
+                if (relata_detalhes) {
+                    escreveRelatorio(relatorio, "<<<-- I >= J -->>> Forma %d (área %.2f) modifica forma %d (área %.2f).\n",
                             getFormaId(forma_I), area_I, getFormaId(forma_J), area_J);
                 }
 
-                //muda a cor de borda de J
-                char corPreenchI[64];
-                strncpy(corPreenchI, getFormaCorPreenchimento(forma_I), 63);
-                corPreenchI[63] = '\0';
-                
-                setFormaCorBorda(forma_J, corPreenchI);
+                //muda a cor de borda de J (só troca o id da cor)
+                setFormaIdCorBorda(forma_J, getFormaIdCorPreenchimento(forma_I));
 
                 //clona I com cores invertidas
                 Forma clone_I = clonarFormaInvertida(forma_I);
@@ -332,8 +403,8 @@ void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue
         }
         else {
             //========== SEM SOBREPOSIÇÃO ==========
-            if (arquivo_txt) {
-                fprintf(arquivo_txt, "Forma %d (I) vs Forma %d (J). NÃO HOUVE SOBREPOSIÇÃO.\n",
+            if (relata_detalhes) {
+                escreveRelatorio(relatorio, "Forma %d (I) vs Forma %d (J). NÃO HOUVE SOBREPOSIÇÃO.\n",
                         getFormaId(forma_I), getFormaId(forma_J));
             }
 
@@ -343,19 +414,24 @@ void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue
     }
 
     //processa forma ímpar (se houver)
-    if (!estaVaziaFila(arena->filaDeFormas)) {
-        Forma ultima = desenfileira(arena->filaDeFormas);
+    if (total_formas_inicial % 2 == 1) {
+        Forma ultima = formas[total_formas_inicial - 1];
         adicionaFormaChao(chao, ultima);
     }
 
+    free(veredictos);
+    free(formas);
+
+    destroiEstilo(estilo_asterisco);
+
     if (pontuacao_total != NULL) {
         *pontuacao_total += area_esmagada_round;
     }
 
-    if (arquivo_txt) {
-        fprintf(arquivo_txt, "\nÁrea total esmagada: %.2f\n", area_esmagada_round);
-        fprintf(arquivo_txt, "Formas esmagadas: %d\n", formas_esmagadas ? *formas_esmagadas : 0);
-        fprintf(arquivo_txt, "Formas clonadas: %d\n\n", formas_clonadas ? *formas_clonadas : 0);
+    if (relata_comandos) {
+        escreveRelatorio(relatorio, "\nÁrea total esmagada: %.2f\n", area_esmagada_round);
+        escreveRelatorio(relatorio, "Formas esmagadas: %d\n", formas_esmagadas ? *formas_esmagadas : 0);
+        escreveRelatorio(relatorio, "Formas clonadas: %d\n\n", formas_clonadas ? *formas_clonadas : 0);
     }
 }
 
@@ -391,6 +467,13 @@ void setArenaAltura(Arena a, double novaAltura) {
     }
 }
 
+void setArenaThreadsCalc(Arena a, int numThreads) {
+    if (a != NULL) {
+        struct Arena_t *arena = (struct Arena_t*) a;
+        arena->threadsCalc = (numThreads < 1) ? 1 : numThreads;
+    }
+}
+
 int getArenaNumFormas(const Arena a) {
     if (a == NULL) {
         return 0;
@@ -7,6 +7,7 @@
 #include "../EstruturaDeDados/fila.h"
 #include "formas.h"
 #include "chao.h"
+#include "relatorioTxt.h"
 
 /*_______________________ TIPO ABSTRATO DE DADOS: ARENA (PALCO PRINCIPAL) _______________________*/
 /*
@@ -54,6 +55,18 @@ Arena criaArena(double largura, double altura);
  */
 void destroiArena(Arena a);
 
+/*
+ Versão de encerramento de 'destroiArena': as formas restantes são apenas
+ descartadas (descartaForma), sem devolver cada célula ao Pool; deve ser
+ seguida de 'liberaTodaMemoriaFormas'.
+
+ * a: A Arena a ser descartada.
+ *
+ * Pós-condição: A memória de 'a' é liberada; as células das formas ficam
+ * para 'liberaTodaMemoriaFormas'.
+ */
+void descartaArena(Arena a);
+
 
 /*________________________________ FUNÇÕES DE MANIPULAÇÃO DE FORMAS ________________________________*/
 
@@ -69,6 +82,20 @@ void destroiArena(Arena a);
  */
 void insereFormaArena(Arena a, Forma f);
 
+/*
+ Insere um lote de formas na Arena de uma só vez, na ordem do vetor
+ (mesmo resultado de chamar insereFormaArena para cada uma).
+
+ * a: A Arena onde as formas serão inseridas.
+ * formas: vetor com as formas a serem adicionadas.
+ * n: quantidade de formas no vetor.
+ *
+ * Pré-condição: 'a' deve ser válida e as n formas não podem ser nulas.
+ * Pós-condição: A Arena passa a ser dona das formas; o vetor continua
+ * pertencendo ao chamador.
+ */
+void insereFormasArena(Arena a, Forma *formas, int n);
+
 /*
   Remove e retorna a próxima forma da arena (fila), assim a primeira que foi inserida
    na arena será a primeira a ser retirada.
@@ -119,16 +146,23 @@ void iteraFormasArena(const Arena a, void (*executa)(Forma f, void *auxData), vo
  *      * Cor de borda de J = cor de preenchimento de I
  *      * Cor de preenchimento de J = cor de borda de I
  *    - Ordem de retorno ao chão: J, depois I, depois clone de I
+ *
+ * A verificação de sobreposição e as áreas de todos os pares são calculadas
+ * antes (em paralelo, se setArenaThreadsCalc pediu mais de uma thread); os
+ * passos acima são aplicados depois, em sequência e na ordem da fila, então
+ * chão, anotações e relatório saem idênticos aos da execução serial.
  *    - Forma I é clonada com cores invertidas (borda↔preenchimento)
  *    - Incrementa contador de formas clonadas
  * 
  *  a:  Arena contendo as formas a serem processadas
  *  chao:  Chão onde as formas serão devolvidas após processamento
- *  arquivo_txt:  Arquivo para log das interações (pode ser NULL)
+ *  relatorio:  Relatório para log das interações (pode ser NULL); os totais
+ *              saem a partir do nível RELATORIO_COMANDOS e cada par só no
+ *              RELATORIO_COMPLETO
  *  formas_clonadas:  Ponteiro para contador de formas clonadas (pode ser NULL)
  *  formas_esmagadas: Ponteiro para contador de formas esmagadas (pode ser NULL)
  */
-void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue anotacoes_svg, FILE *arquivo_txt, int *formas_clonadas, int *formas_esmagadas, void *repo);
+void processaInteracoesArena(Arena a, Chao chao, double *pontuacao_total, Queue anotacoes_svg, RelatorioTxt relatorio, int *formas_clonadas, int *formas_esmagadas, void *repo);
 
 /*___________________________ FUNÇÕES DE CONSULTA E MODIFICAÇÃO DE ATRIBUTOS ___________________________*/
 
@@ -184,6 +218,18 @@ void setArenaLargura(Arena a, double novaLargura);
  */
 void setArenaAltura(Arena a, double novaAltura);
 
+/*
+ Define quantas threads processaInteracoesArena pode usar para avaliar os
+ pares (I, J). Lotes pequenos usam menos threads que o pedido.
+
+ * a: Ponteiro para a Arena a ser modificada.
+ * numThreads: número de threads (valores menores que 1 valem como 1).
+ *
+ * Pré-condição: 'a' deve ser um ponteiro válido.
+ * Pós-condição: os próximos calc usam até 'numThreads' threads.
+ */
+void setArenaThreadsCalc(Arena a, int numThreads);
+
 
 
 #endif 
\ No newline at end of file
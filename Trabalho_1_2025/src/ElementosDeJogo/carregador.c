@@ -136,6 +136,25 @@ void insereFormaCarregador(Carregador c, Forma f) {
     empilha(carr->pilhaDeFormas, f);
 }
 
+void transfereFormasCarregador(Carregador origem, Carregador destino, int n) {
+    if (origem == NULL || destino == NULL) {
+        return;
+    }
+
+    struct Carregador_t *o = (struct Carregador_t *)origem;
+    struct Carregador_t *d = (struct Carregador_t *)destino;
+    transferePilha(o->pilhaDeFormas, d->pilhaDeFormas, n);
+}
+
+int descarregaFormas(Carregador c, Forma *destino, int n) {
+    if (c == NULL || destino == NULL) {
+        return 0;
+    }
+
+    struct Carregador_t *carr = (struct Carregador_t *)c;
+    return desempilhaVetor(carr->pilhaDeFormas, destino, n);
+}
+
 
 /*________________________________ FUNÇÕES GET ________________________________*/
 
@@ -99,6 +99,35 @@ Forma descarregaForma(Carregador c);
  */
 void insereFormaCarregador(Carregador c, Forma f);
 
+/*
+ Move as n formas do topo de um Carregador para o topo de outro, com o
+ mesmo resultado de n chamadas a descarregaForma seguidas de
+ insereFormaCarregador, mas sem passar forma a forma pela interface.
+
+ * origem: O Carregador de onde as formas saem.
+ * destino: O Carregador que recebe as formas.
+ * n: Quantidade de formas (limitada ao tamanho da origem).
+
+ * Pré-condição: 'origem' e 'destino' devem ser válidos.
+ * Pós-condição: a ordem das formas movidas fica invertida no destino
+ * (o antigo topo da origem fica embaixo). Se origem e destino forem o
+ * mesmo Carregador nada muda.
+ */
+void transfereFormasCarregador(Carregador origem, Carregador destino, int n);
+
+/*
+ Remove as n formas do topo do Carregador de uma vez, gravando-as em um
+ vetor na ordem em que descarregaForma as devolveria.
+
+ * c: O Carregador de onde as formas serão removidas.
+ * destino: vetor com espaço para pelo menos n formas.
+ * n: Quantidade de formas (limitada ao tamanho do Carregador).
+
+ * Pré-condição: 'c' e 'destino' devem ser válidos.
+ * Pós-condição: Retorna quantas formas foram removidas.
+ */
+int descarregaFormas(Carregador c, Forma *destino, int n);
+
 
 /*________________________________ FUNÇÕES GET ________________________________*/
 
@@ -48,6 +48,22 @@ void destroiChao(Chao c) {
     free(chao);
 }
 
+static void descartaFormaFila(Item i, void *auxData) {
+    (void) auxData;
+    descartaForma((Forma) i);
+}
+
+void descartaChao(Chao c) {
+    if (c == NULL) {
+        return;
+    }
+
+    struct Chao_t *chao = (struct Chao_t*) c;
+    iteraFila(chao->fila_de_formas, descartaFormaFila, NULL);
+    destroiFila(chao->fila_de_formas);
+    free(chao);
+}
+
 
 /*________________________________ FUNÇÕES DE MANIPULAÇÃO ________________________________*/
 
@@ -92,4 +108,13 @@ int getChaoTamanho(const Chao c) {
     
     struct Chao_t *chao = (struct Chao_t*) c;
     return getTamanhoFila(chao->fila_de_formas);
+}
+
+void iteraFormasChao(const Chao c, void (*executa)(Forma f, void *auxData), void *auxData) {
+    if (c == NULL || executa == NULL) {
+        return;
+    }
+
+    struct Chao_t *chao = (struct Chao_t*) c;
+    iteraFila(chao->fila_de_formas, executa, auxData);
 }
\ No newline at end of file
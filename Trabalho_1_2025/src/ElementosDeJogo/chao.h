@@ -51,6 +51,18 @@ estiverem contidas no Chão no momento da chamada.
 */
 void destroiChao(Chao c);
 
+/*
+Versão de encerramento de 'destroiChao': as formas restantes são apenas
+descartadas (descartaForma), sem devolver cada célula ao Pool; deve ser
+seguida de 'liberaTodaMemoriaFormas'.
+
+* c: Ponteiro para o Chão a ser descartado.
+*
+* Pós-condição: A memória de 'c' é liberada; as células das formas ficam
+* para 'liberaTodaMemoriaFormas'.
+*/
+void descartaChao(Chao c);
+
 
 /*________________________________ FUNÇÕES DE MANIPULAÇÃO ________________________________*/
 /*
@@ -97,4 +109,18 @@ Retorna a quantidade de formas atualmente armazenadas no Chão.
 */
 int getChaoTamanho(const Chao c);
 
+/*
+Itera sobre todas as formas contidas no Chão, na ordem da fila, e executa
+uma função para cada uma. As formas não são removidas nem reinseridas.
+
+* c: O Chão cujas formas serão iteradas.
+* executa: Ponteiro para uma função que será chamada para cada forma.
+* Esta função recebe a Forma e um dado auxiliar.
+* auxData: Ponteiro para dados extras que a função 'executa' possa precisar.
+*
+* Pré-condição: 'c' e 'executa' devem ser ponteiros válidos.
+* Pós-condição: A função 'executa' é aplicada a cada forma do Chão.
+*/
+void iteraFormasChao(const Chao c, void (*executa)(Forma f, void *auxData), void *auxData);
+
 #endif
\ No newline at end of file
@@ -169,33 +169,42 @@ void preparaDisparo(Disparador d, char lado, int n) {
     Carregador carregadorOrigem = (ladoNormalizado == 'D') ? disp->carregadorEsq : disp->carregadorDir;
     Carregador carregadorOposto = (ladoNormalizado == 'D') ? disp->carregadorDir : disp->carregadorEsq;
 
-    // Repete a operação 'n' vezes para "ciclar" as formas
-    for (int i = 0; i < n; i++) {
-        DEBUG_PRINT("DEBUG PREP: Iteracao %d - Forma atual em disparo: %p\n", 
-                   i, (void*)disp->formaPronta);
-
-        // Se já há uma forma pronta, move ela para o carregador oposto
-        if (disp->formaPronta != NULL) {
-            DEBUG_PRINT("DEBUG PREP: Movendo forma ID=%d do disparo para carregador oposto\n",
-                       getFormaId(disp->formaPronta));
-            
-            insereFormaCarregador(carregadorOposto, disp->formaPronta);
-            disp->formaPronta = NULL;
+    // Os dois carregadores e a posição de disparo formam uma sequência só:
+    // topo da origem -> forma pronta -> topo do oposto. Cada passo de 'n'
+    // empurra a forma pronta para o oposto e puxa o topo da origem, então
+    // o resultado de n passos é calculado direto, sem repetir o ciclo:
+    //   - n <= tamanho da origem: a forma pronta e as n-1 primeiras da
+    //     origem vão para o oposto, e a n-ésima fica pronta;
+    //   - n > tamanho da origem: tudo vai para o oposto e o disparo fica
+    //     vazio (o ciclo original parava ao achar a origem vazia).
+    if (carregadorOrigem == carregadorOposto) {
+        // mesmo carregador dos dois lados: a forma pronta entra e sai do
+        // mesmo topo, então só o primeiro passo muda alguma coisa
+        if (disp->formaPronta == NULL) {
+            disp->formaPronta = descarregaForma(carregadorOrigem);
         }
+        return;
+    }
 
-        // Verifica se o carregador de origem tem formas
-        if (carregadorEstaVazio(carregadorOrigem)) {
-            DEBUG_PRINT("DEBUG PREP: Carregador de origem vazio. Nenhuma forma movida para disparo.\n");
-            break;
-        }
+    int tamanhoOrigem = getCarregadorTamanho(carregadorOrigem);
 
-        // Pega a próxima forma do carregador de origem
+    if (disp->formaPronta != NULL) {
+        DEBUG_PRINT("DEBUG PREP: Movendo forma ID=%d do disparo para carregador oposto\n",
+                   getFormaId(disp->formaPronta));
+
+        insereFormaCarregador(carregadorOposto, disp->formaPronta);
+        disp->formaPronta = NULL;
+    }
+
+    if (n <= tamanhoOrigem) {
+        transfereFormasCarregador(carregadorOrigem, carregadorOposto, n - 1);
         disp->formaPronta = descarregaForma(carregadorOrigem);
-        
-        if (disp->formaPronta != NULL) {
-            DEBUG_PRINT("DEBUG PREP: Forma ID=%d colocada em posicao de disparo\n",
-                       getFormaId(disp->formaPronta));
-        }
+
+        DEBUG_PRINT("DEBUG PREP: Forma ID=%d colocada em posicao de disparo\n",
+                   getFormaId(disp->formaPronta));
+    } else {
+        transfereFormasCarregador(carregadorOrigem, carregadorOposto, tamanhoOrigem);
+        DEBUG_PRINT("DEBUG PREP: Carregador de origem vazio. Nenhuma forma movida para disparo.\n");
     }
 }
 
@@ -235,4 +244,71 @@ Forma dispara(Disparador d, double dx, double dy) {
                getFormaId(formaDisparada), posX_final, posY_final);
 
     return formaDisparada;
-}
\ No newline at end of file
+}
+Forma *disparaRajada(Disparador d, char lado, double dx, double dy,
+                     double ix, double iy, int *quantidade) {
+    *quantidade = 0;
+    if (d == NULL) {
+        return NULL;
+    }
+
+    struct Disparador_t *disp = (struct Disparador_t *)d;
+
+    bool carregadoresValidos = (disp->carregadorEsq != NULL && disp->carregadorDir != NULL);
+    bool ladoValido = (lado == 'E' || lado == 'D' || lado == 'e' || lado == 'd');
+
+    if (!carregadoresValidos || !ladoValido) {
+        // nada sai dos carregadores: só a forma que já estava pronta é
+        // disparada, e preparaDisparo repete o aviso a cada tentativa
+        preparaDisparo(d, lado, 1);
+        if (disp->formaPronta == NULL) {
+            return NULL;
+        }
+
+        Forma *rajada = malloc(sizeof(Forma));
+        if (rajada == NULL) {
+            printf("ERRO: Falha ao alocar memoria para a rajada.\n");
+            exit(1);
+        }
+        rajada[0] = dispara(d, dx, dy);
+        *quantidade = 1;
+
+        preparaDisparo(d, lado, 1);
+        return rajada;
+    }
+
+    char ladoNormalizado = (lado == 'e') ? 'E' : (lado == 'd') ? 'D' : lado;
+    Carregador carregadorOrigem = (ladoNormalizado == 'D') ? disp->carregadorEsq : disp->carregadorDir;
+    Carregador carregadorOposto = (ladoNormalizado == 'D') ? disp->carregadorDir : disp->carregadorEsq;
+
+    // o primeiro preparo manda a forma que já estava pronta para o oposto
+    // (se oposto e origem forem o mesmo carregador, ela é a primeira a sair)
+    if (disp->formaPronta != NULL) {
+        insereFormaCarregador(carregadorOposto, disp->formaPronta);
+        disp->formaPronta = NULL;
+    }
+
+    int n = getCarregadorTamanho(carregadorOrigem);
+    if (n == 0) {
+        return NULL;
+    }
+
+    Forma *rajada = malloc((size_t) n * sizeof(Forma));
+    if (rajada == NULL) {
+        printf("ERRO: Falha ao alocar memoria para a rajada.\n");
+        exit(1);
+    }
+    descarregaFormas(carregadorOrigem, rajada, n);
+
+    // mesma conta de dispara(d, dx + i*ix, dy + i*iy)
+    for (int i = 0; i < n; i++) {
+        double dx_atual = dx + i * ix;
+        double dy_atual = dy + i * iy;
+        setFormaPosicao(rajada[i], disp->x + dx_atual, disp->y + dy_atual);
+    }
+
+    DEBUG_PRINT("DEBUG DISP: Rajada de %d formas pelo disparador %d\n", n, disp->id);
+
+    *quantidade = n;
+    return rajada;
+}
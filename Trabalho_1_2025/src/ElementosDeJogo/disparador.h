@@ -130,7 +130,9 @@ void setDisparadorPosicao(Disparador d, double x, double y);
  * n: O número de vezes que a operação é repetida (para "ciclar" as formas).
  *
  * Pré-condição: 'd' deve ser um ponteiro válido; 'lado' deve ser 'E' ou 'D'.
- * Pós-condição: A Forma na posição de disparo é atualizada.
+ * Pós-condição: A Forma na posição de disparo é atualizada. O resultado é o
+ * mesmo de repetir a operação n vezes, mas é calculado de uma vez, com custo
+ * proporcional a min(n, tamanho do carregador de origem).
  */
 void preparaDisparo(Disparador d, char lado, int n);
 
@@ -150,6 +152,27 @@ void preparaDisparo(Disparador d, char lado, int n);
  */
 Forma dispara(Disparador d, double dx, double dy);
 
+/*
+ Rajada de disparos: esvazia o Carregador de origem em uma única passada,
+ com o mesmo resultado de repetir preparaDisparo(d, lado, 1) seguido de
+ dispara até não haver mais forma pronta. O i-ésimo disparo (a partir de 0)
+ usa o deslocamento (dx + i*ix, dy + i*iy).
+
+ * d: O Disparador que efetuará a rajada.
+ * lado: O Carregador de origem ('E' ou 'D'), como em preparaDisparo.
+ * dx, dy: deslocamento do primeiro disparo.
+ * ix, iy: incremento do deslocamento a cada disparo.
+ * quantidade: recebe o número de formas disparadas.
+ *
+ * Pré-condição: 'd' e 'quantidade' devem ser ponteiros válidos.
+ * Pós-condição: Retorna um vetor alocado com as formas disparadas, na ordem
+ * dos disparos e com as coordenadas atualizadas, ou NULL se nenhuma forma
+ * foi disparada. Quem chamou a função fica responsável por liberar o vetor
+ * (com free) e pelas formas.
+ */
+Forma *disparaRajada(Disparador d, char lado, double dx, double dy,
+                     double ix, double iy, int *quantidade);
+
 
 /*
  Reconecta o Disparador a novos Carregadores.
@@ -0,0 +1,169 @@
+#ifndef GEOMETRIA_H
+#define GEOMETRIA_H
+
+#include <stdbool.h>
+#include <math.h>
+
+/*
+*        NÚCLEOS GEOMÉTRICOS DE INTERSEÇÃO
+*
+*        Funções puras sobre coordenadas (doubles), sem acesso aos TADs e
+*        sem alocação. São 'static inline' para que o compilador possa
+*        inseri-las diretamente nos adaptadores de sobreposicao.c.
+*
+*        Convenções:
+*            círculo: centro (cx, cy) e raio r
+*            retângulo: canto (rx, ry), largura w e altura h
+*            segmento: extremidades (x1, y1) e (x2, y2)
+*/
+
+
+// Distância ao quadrado entre (x1, y1) e (x2, y2)
+static inline double distanciaQuadradaGeo(double x1, double y1, double x2, double y2) {
+    double dx = x1 - x2;
+    double dy = y1 - y2;
+    return dx * dx + dy * dy;
+}
+
+/*
+Orientação dos pontos ordenados (p, q, r) pelo produto vetorial.
+Retorna: 0 se colineares, 1 se horário, 2 se anti-horário
+*/
+static inline int orientacaoGeo(double px, double py, double qx, double qy, double rx, double ry) {
+    double val = (qy - py) * (rx - qx) - (qx - px) * (ry - qy);
+    if (fabs(val) < 1e-10) return 0;  //colinear
+    return (val > 0) ? 1 : 2;  //1: horário, 2: anti-horário
+}
+
+// Verifica se q está no segmento pr, supondo os três pontos colineares
+static inline bool pontoNoSegmentoGeo(double px, double py, double qx, double qy, double rx, double ry) {
+    return (qx <= fmax(px, rx) && qx >= fmin(px, rx) &&
+            qy <= fmax(py, ry) && qy >= fmin(py, ry));
+}
+
+// Verifica se (px, py) está dentro do retângulo (bordas inclusas)
+static inline bool pontoNoRetanguloGeo(double px, double py, double rx, double ry, double w, double h) {
+    return (px >= rx && px <= rx + w && py >= ry && py <= ry + h);
+}
+
+// Interseção entre dois círculos (tangentes contam)
+static inline bool intersecaoCirculoCirculo(double x1, double y1, double r1,
+                                            double x2, double y2, double r2) {
+    double somaRaios = r1 + r2;
+    return distanciaQuadradaGeo(x1, y1, x2, y2) <= somaRaios * somaRaios;
+}
+
+// Interseção entre círculo e retângulo pelo ponto do retângulo mais próximo do centro
+static inline bool intersecaoCirculoRetangulo(double cx, double cy, double r,
+                                              double rx, double ry, double w, double h) {
+    double px = cx;
+    double py = cy;
+
+    if (cx < rx) px = rx;
+    else if (cx > rx + w) px = rx + w;
+
+    if (cy < ry) py = ry;
+    else if (cy > ry + h) py = ry + h;
+
+    return distanciaQuadradaGeo(cx, cy, px, py) <= r * r;
+}
+
+// Interseção entre círculo e segmento (extremidades ou projeção do centro)
+static inline bool intersecaoCirculoSegmento(double cx, double cy, double r,
+                                             double x1, double y1, double x2, double y2) {
+    double rQuad = r * r;
+
+    if (distanciaQuadradaGeo(cx, cy, x1, y1) <= rQuad ||
+        distanciaQuadradaGeo(cx, cy, x2, y2) <= rQuad) {
+        return true;
+    }
+
+    double compQuad = distanciaQuadradaGeo(x1, y1, x2, y2);
+    if (compQuad == 0) return false;
+
+    double t = ((cx - x1) * (x2 - x1) + (cy - y1) * (y2 - y1)) / compQuad;
+    if (t < 0 || t > 1) return false;
+
+    double px = x1 + t * (x2 - x1);
+    double py = y1 + t * (y2 - y1);
+
+    return distanciaQuadradaGeo(cx, cy, px, py) <= rQuad;
+}
+
+// Interseção entre dois retângulos (bordas que apenas se tocam não contam)
+static inline bool intersecaoRetanguloRetangulo(double x1, double y1, double w1, double h1,
+                                                double x2, double y2, double w2, double h2) {
+    bool sobreX = (x1 < x2 + w2) && (x1 + w1 > x2);
+    bool sobreY = (y1 < y2 + h2) && (y1 + h1 > y2);
+    return sobreX && sobreY;
+}
+
+// Interseção entre os segmentos (x1,y1)-(x2,y2) e (x3,y3)-(x4,y4), incluindo colineares
+static inline bool intersecaoSegmentoSegmento(double x1, double y1, double x2, double y2,
+                                              double x3, double y3, double x4, double y4) {
+    int o1 = orientacaoGeo(x1, y1, x2, y2, x3, y3);
+    int o2 = orientacaoGeo(x1, y1, x2, y2, x4, y4);
+    int o3 = orientacaoGeo(x3, y3, x4, y4, x1, y1);
+    int o4 = orientacaoGeo(x3, y3, x4, y4, x2, y2);
+
+    //caso geral
+    if (o1 != o2 && o3 != o4) return true;
+
+    //casos especiais (colineares)
+    if (o1 == 0 && pontoNoSegmentoGeo(x1, y1, x3, y3, x2, y2)) return true;
+    if (o2 == 0 && pontoNoSegmentoGeo(x1, y1, x4, y4, x2, y2)) return true;
+    if (o3 == 0 && pontoNoSegmentoGeo(x3, y3, x1, y1, x4, y4)) return true;
+    if (o4 == 0 && pontoNoSegmentoGeo(x3, y3, x2, y2, x4, y4)) return true;
+
+    return false;
+}
+
+// Interseção entre retângulo e segmento: extremidade dentro ou cruzamento com uma das bordas
+static inline bool intersecaoRetanguloSegmento(double rx, double ry, double w, double h,
+                                               double x1, double y1, double x2, double y2) {
+    if (pontoNoRetanguloGeo(x1, y1, rx, ry, w, h) || pontoNoRetanguloGeo(x2, y2, rx, ry, w, h)) {
+        return true;
+    }
+
+    return intersecaoSegmentoSegmento(x1, y1, x2, y2, rx, ry, rx + w, ry) ||                  // topo
+           intersecaoSegmentoSegmento(x1, y1, x2, y2, rx + w, ry, rx + w, ry + h) ||          // direita
+           intersecaoSegmentoSegmento(x1, y1, x2, y2, rx + w, ry + h, rx, ry + h) ||          // baixo
+           intersecaoSegmentoSegmento(x1, y1, x2, y2, rx, ry + h, rx, ry);                    // esquerda
+}
+
+/*
+Segmento horizontal ocupado por um texto de 'numCaracteres' caracteres
+ancorado em (xt, yt), com 10 unidades por caractere:
+    - 'i' (início): [xt, xt+comprimento]
+    - 'm' (meio): [xt-comprimento/2, xt+comprimento/2]
+    - 'f' (fim): [xt-comprimento, xt]
+Âncora desconhecida resulta em um segmento degenerado em xt.
+*/
+static inline void segmentoTextoGeo(double xt, double yt, char ancora, int numCaracteres,
+                                    double *x1, double *y1, double *x2, double *y2) {
+    double comprimento = 10.0 * numCaracteres;
+
+    *y1 = yt;
+    *y2 = yt;
+
+    switch (ancora) {
+        case 'i':
+            *x1 = xt;
+            *x2 = xt + comprimento;
+            break;
+        case 'm':
+            *x1 = xt - comprimento / 2.0;
+            *x2 = xt + comprimento / 2.0;
+            break;
+        case 'f':
+            *x1 = xt - comprimento;
+            *x2 = xt;
+            break;
+        default:
+            *x1 = xt;
+            *x2 = xt;
+            break;
+    }
+}
+
+#endif
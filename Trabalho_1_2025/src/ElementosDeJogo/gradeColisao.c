@@ -0,0 +1,323 @@
+#include "gradeColisao.h"
+
+#include "sobreposicao.h"
+#include "geometria.h"
+#include "circulo.h"
+#include "retangulo.h"
+#include "linha.h"
+#include "texto.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// formas que cobririam mais células que isso são tratadas fora da grade
+#define LIMITE_CELULAS_FORMA 64
+
+// a grade tem no máximo CELULAS_POR_FORMA * n células
+#define CELULAS_POR_FORMA 4
+
+typedef struct {
+    double xMin, yMin, xMax, yMax;
+} Caixa;
+
+typedef struct {
+    double x0, y0;      // canto da grade
+    double tamanho;     // lado de uma célula
+    int colunas, linhas;
+    int *inicio;        // células em formato compacto: itens de c em [inicio[c], inicio[c+1])
+    int *itens;
+} Grade;
+
+// vetor de pares que cresce dobrando
+typedef struct {
+    int *v;
+    int quantidade;
+    int capacidade;
+} ListaPares;
+
+
+/*________________________________ AUXILIARES ________________________________*/
+
+static void *alocaGrade(size_t tamanho) {
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+    if (p == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void adicionaPar(ListaPares *l, int i, int j) {
+    if (l->quantidade == l->capacidade) {
+        int novaCapacidade = (l->capacidade == 0) ? 64 : l->capacidade * 2;
+        int *novo = (int*) realloc(l->v, 2 * (size_t) novaCapacidade * sizeof(int));
+        if (novo == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+        l->v = novo;
+        l->capacidade = novaCapacidade;
+    }
+    l->v[2 * l->quantidade] = i;
+    l->v[2 * l->quantidade + 1] = j;
+    l->quantidade++;
+}
+
+static int comparaPares(const void *a, const void *b) {
+    const int *p = (const int*) a;
+    const int *q = (const int*) b;
+    if (p[0] != q[0]) return (p[0] < q[0]) ? -1 : 1;
+    if (p[1] != q[1]) return (p[1] < q[1]) ? -1 : 1;
+    return 0;
+}
+
+// caixa envolvente com as mesmas coordenadas usadas em sobreposicao.c
+static Caixa caixaForma(const Forma f) {
+    Caixa c;
+    void *dados = getFormaAssoc(f);
+
+    switch (getFormaTipo(f)) {
+        case TIPO_CIRCULO: {
+            double x = getXCirculo(dados), y = getYCirculo(dados), r = fabs(getRCirculo(dados));
+            c.xMin = x - r; c.xMax = x + r;
+            c.yMin = y - r; c.yMax = y + r;
+            break;
+        }
+        case TIPO_RETANGULO: {
+            double x = getXRetangulo(dados), y = getYRetangulo(dados);
+            double fimX = x + getLarguraRetangulo(dados), fimY = y + getAlturaRetangulo(dados);
+            c.xMin = fmin(x, fimX); c.xMax = fmax(x, fimX);
+            c.yMin = fmin(y, fimY); c.yMax = fmax(y, fimY);
+            break;
+        }
+        case TIPO_LINHA: {
+            double x1 = getX1Linha(dados), y1 = getY1Linha(dados);
+            double x2 = getX2Linha(dados), y2 = getY2Linha(dados);
+            c.xMin = fmin(x1, x2); c.xMax = fmax(x1, x2);
+            c.yMin = fmin(y1, y2); c.yMax = fmax(y1, y2);
+            break;
+        }
+        case TIPO_TEXTO: {
+            double x1, y1, x2, y2;
+            converterTextoParaLinha(dados, &x1, &y1, &x2, &y2);
+            c.xMin = fmin(x1, x2); c.xMax = fmax(x1, x2);
+            c.yMin = fmin(y1, y2); c.yMax = fmax(y1, y2);
+            break;
+        }
+        default:
+            c.xMin = c.yMin = c.xMax = c.yMax = NAN;
+            break;
+    }
+    return c;
+}
+
+static bool caixaFinita(const Caixa *c) {
+    return isfinite(c->xMin) && isfinite(c->yMin) && isfinite(c->xMax) && isfinite(c->yMax);
+}
+
+// caixas que se tocam (bordas inclusas), como os testes com tangência
+static bool caixasSeTocam(const Caixa *a, const Caixa *b) {
+    return a->xMin <= b->xMax && b->xMin <= a->xMax &&
+           a->yMin <= b->yMax && b->yMin <= a->yMax;
+}
+
+// coluna (ou linha) da coordenada v, limitada à grade
+static int celulaEixo(double v, double origem, double tamanho, int maximo) {
+    double k = floor((v - origem) / tamanho);
+    if (k < 0) return 0;
+    if (k >= maximo) return maximo - 1;
+    return (int) k;
+}
+
+
+/*________________________________ CONSTRUÇÃO DA GRADE ________________________________*/
+
+// escolhe o tamanho da célula pelo tamanho médio das caixas, limitando o
+// total de células a CELULAS_POR_FORMA por forma
+static void dimensionaGrade(Grade *g, const Caixa *caixas, const bool *naGrade, int n) {
+    double xMin = INFINITY, yMin = INFINITY, xMax = -INFINITY, yMax = -INFINITY;
+    double somaLados = 0.0;
+    int contadas = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (!naGrade[i]) continue;
+        xMin = fmin(xMin, caixas[i].xMin); xMax = fmax(xMax, caixas[i].xMax);
+        yMin = fmin(yMin, caixas[i].yMin); yMax = fmax(yMax, caixas[i].yMax);
+        somaLados += fmax(caixas[i].xMax - caixas[i].xMin, caixas[i].yMax - caixas[i].yMin);
+        contadas++;
+    }
+
+    if (contadas == 0) {
+        g->x0 = g->y0 = 0.0;
+        g->tamanho = 1.0;
+        g->colunas = g->linhas = 1;
+        return;
+    }
+
+    double largura = xMax - xMin;
+    double altura = yMax - yMin;
+    double tamanho = somaLados / contadas;
+    if (!(tamanho > 0.0)) {
+        // caixas todas pontuais: espalha as formas pela área ocupada
+        tamanho = fmax(largura, altura) / sqrt((double) contadas);
+    }
+    if (!(tamanho > 0.0) || !isfinite(tamanho)) {
+        tamanho = 1.0;
+    }
+
+    // dobra a célula até a grade caber no limite de células
+    double limiteCelulas = (double) CELULAS_POR_FORMA * contadas;
+    double colunas = floor(largura / tamanho) + 1.0;
+    double linhas = floor(altura / tamanho) + 1.0;
+    while (colunas * linhas > limiteCelulas) {
+        tamanho *= 2.0;
+        colunas = floor(largura / tamanho) + 1.0;
+        linhas = floor(altura / tamanho) + 1.0;
+    }
+
+    g->x0 = xMin;
+    g->y0 = yMin;
+    g->tamanho = tamanho;
+    g->colunas = (int) colunas;
+    g->linhas = (int) linhas;
+}
+
+static int numCelulasCaixa(const Grade *g, const Caixa *c) {
+    int c0 = celulaEixo(c->xMin, g->x0, g->tamanho, g->colunas);
+    int c1 = celulaEixo(c->xMax, g->x0, g->tamanho, g->colunas);
+    int l0 = celulaEixo(c->yMin, g->y0, g->tamanho, g->linhas);
+    int l1 = celulaEixo(c->yMax, g->y0, g->tamanho, g->linhas);
+    return (c1 - c0 + 1) * (l1 - l0 + 1);
+}
+
+// registra as formas da grade em cada célula que suas caixas tocam
+// (duas passadas: conta por célula, depois preenche)
+static void preencheGrade(Grade *g, const Caixa *caixas, const bool *naGrade, int n) {
+    int numCelulas = g->colunas * g->linhas;
+    g->inicio = (int*) alocaGrade(((size_t) numCelulas + 1) * sizeof(int));
+    memset(g->inicio, 0, ((size_t) numCelulas + 1) * sizeof(int));
+
+    for (int passada = 0; passada < 2; passada++) {
+        for (int i = 0; i < n; i++) {
+            if (!naGrade[i]) continue;
+            int c0 = celulaEixo(caixas[i].xMin, g->x0, g->tamanho, g->colunas);
+            int c1 = celulaEixo(caixas[i].xMax, g->x0, g->tamanho, g->colunas);
+            int l0 = celulaEixo(caixas[i].yMin, g->y0, g->tamanho, g->linhas);
+            int l1 = celulaEixo(caixas[i].yMax, g->y0, g->tamanho, g->linhas);
+            for (int l = l0; l <= l1; l++) {
+                for (int c = c0; c <= c1; c++) {
+                    int celula = l * g->colunas + c;
+                    if (passada == 0) {
+                        g->inicio[celula + 1]++;
+                    } else {
+                        g->itens[g->inicio[celula]++] = i;
+                    }
+                }
+            }
+        }
+
+        if (passada == 0) {
+            for (int c = 0; c < numCelulas; c++) {
+                g->inicio[c + 1] += g->inicio[c];
+            }
+            g->itens = (int*) alocaGrade((size_t) g->inicio[numCelulas] * sizeof(int));
+        } else {
+            // o preenchimento avançou cada início até o fim da célula;
+            // desloca de volta uma posição para restaurar os inícios
+            for (int c = numCelulas; c > 0; c--) {
+                g->inicio[c] = g->inicio[c - 1];
+            }
+            g->inicio[0] = 0;
+        }
+    }
+}
+
+
+/*________________________________ BUSCA DOS PARES ________________________________*/
+
+int calculaParesSobrepostos(const Forma *formas, int n, int **pares) {
+    *pares = NULL;
+    if (formas == NULL || n < 2) {
+        return 0;
+    }
+
+    Caixa *caixas = (Caixa*) alocaGrade((size_t) n * sizeof(Caixa));
+    bool *naGrade = (bool*) alocaGrade((size_t) n * sizeof(bool));
+    for (int i = 0; i < n; i++) {
+        caixas[i] = caixaForma(formas[i]);
+        naGrade[i] = caixaFinita(&caixas[i]);
+    }
+
+    Grade g;
+    dimensionaGrade(&g, caixas, naGrade, n);
+
+    // formas grandes demais para a grade vão para a lista de avulsas
+    int *avulsas = (int*) alocaGrade((size_t) n * sizeof(int));
+    int numAvulsas = 0;
+    for (int i = 0; i < n; i++) {
+        if (!naGrade[i] || numCelulasCaixa(&g, &caixas[i]) > LIMITE_CELULAS_FORMA) {
+            naGrade[i] = false;
+            avulsas[numAvulsas++] = i;
+        }
+    }
+
+    preencheGrade(&g, caixas, naGrade, n);
+
+    ListaPares lista = {NULL, 0, 0};
+
+    // pares dentro de cada célula; um par que divide várias células só é
+    // testado na célula do canto inferior da interseção das duas caixas
+    for (int l = 0; l < g.linhas; l++) {
+        for (int c = 0; c < g.colunas; c++) {
+            int celula = l * g.colunas + c;
+            for (int a = g.inicio[celula]; a < g.inicio[celula + 1]; a++) {
+                int i = g.itens[a];
+                for (int b = a + 1; b < g.inicio[celula + 1]; b++) {
+                    int j = g.itens[b];
+                    if (!caixasSeTocam(&caixas[i], &caixas[j])) continue;
+
+                    double xRef = fmax(caixas[i].xMin, caixas[j].xMin);
+                    double yRef = fmax(caixas[i].yMin, caixas[j].yMin);
+                    if (celulaEixo(xRef, g.x0, g.tamanho, g.colunas) != c ||
+                        celulaEixo(yRef, g.y0, g.tamanho, g.linhas) != l) continue;
+
+                    if (sobrepoe(formas[i], formas[j])) {
+                        adicionaPar(&lista, i, j);   // i < j: itens saem em ordem crescente
+                    }
+                }
+            }
+        }
+    }
+
+    // avulsas contra todas as outras (entre duas avulsas, uma vez só);
+    // caixas não finitas vão direto ao teste exato
+    for (int a = 0; a < numAvulsas; a++) {
+        int i = avulsas[a];
+        bool finitaI = caixaFinita(&caixas[i]);
+        for (int j = 0; j < n; j++) {
+            if (j == i || (!naGrade[j] && j < i)) continue;
+            bool finitaJ = caixaFinita(&caixas[j]);
+            if (finitaI && finitaJ && !caixasSeTocam(&caixas[i], &caixas[j])) continue;
+
+            if (sobrepoe(formas[i], formas[j])) {
+                if (i < j) adicionaPar(&lista, i, j);
+                else adicionaPar(&lista, j, i);
+            }
+        }
+    }
+
+    if (lista.quantidade > 1) {
+        qsort(lista.v, lista.quantidade, 2 * sizeof(int), comparaPares);
+    }
+
+    free(g.inicio);
+    free(g.itens);
+    free(avulsas);
+    free(naGrade);
+    free(caixas);
+
+    *pares = lista.v;
+    return lista.quantidade;
+}
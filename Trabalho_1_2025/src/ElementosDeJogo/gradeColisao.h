@@ -0,0 +1,44 @@
+#ifndef GRADECOLISAO_H
+#define GRADECOLISAO_H
+
+#include "formas.h"
+
+/*
+*        GRADE UNIFORME DE COLISÃO (FASE AMPLA)
+*
+*        Encontra todos os pares de formas que se sobrepõem em um conjunto,
+*        sem testar todos os N² pares. Cada forma é reduzida à sua caixa
+*        envolvente (alinhada aos eixos) e registrada nas células de uma
+*        grade uniforme que essas caixas tocam; o teste exato de
+*        sobreposicao.h só é feito para pares que dividem alguma célula e
+*        cujas caixas se tocam.
+*
+*        Caixas envolventes:
+*            círculo: centro ± raio
+*            retângulo: [x, x+w] x [y, y+h]
+*            linha: extremidades
+*            texto: o segmento usado nos testes de sobreposição do texto
+*
+*        Formas cujas caixas cobririam células demais (linhas muito longas,
+*        por exemplo) não entram na grade: são comparadas com todas as
+*        outras pela caixa, o que mantém a grade pequena.
+*/
+
+/*
+Calcula todos os pares de formas sobrepostas.
+
+* formas: vetor com as formas
+* n: quantidade de formas no vetor
+* pares: recebe um vetor alocado com 2 * (valor retornado) índices, em que
+*        o par k é (pares[2k], pares[2k+1]), com pares[2k] < pares[2k+1].
+*        Os pares vêm ordenados pelo primeiro índice e depois pelo segundo.
+*        Recebe NULL quando não há pares.
+*
+* Pré-condição: as n formas devem ser válidas
+* Pós-condição: retorna a quantidade de pares sobrepostos (o mesmo resultado
+* de testar sobrepoe() em todos os pares); o chamador libera '*pares' com
+* free. O programa é encerrado em caso de falha de alocação.
+*/
+int calculaParesSobrepostos(const Forma *formas, int n, int **pares);
+
+#endif
@@ -17,6 +17,8 @@
 *
 *        Contém uma função mestre que identifica os tipos das formas
 *        e delega para funções especialistas a verificação específica.
+*        As especialistas só leem as coordenadas dos TADs; a geometria
+*        em si fica nos núcleos de geometria.h e não aloca memória.
 */
 
 
@@ -33,6 +35,19 @@ Pós-condição: retorna true se há sobreposição, false caso contrário
 */
 bool formasSobrepoem(Forma f1, Forma f2);
 
+/*
+Mesma verificação de formasSobrepoem, feita por uma tabela 4x4 de funções
+especialistas indexada pelos tipos das formas (na ordem de TipoForma).
+A tabela já cuida dos pares em ordem invertida (ex: retângulo x círculo),
+então não há cadeia de comparações de tipo.
+
+f1, f2: ponteiros para as formas a serem verificadas
+
+Pós-condição: retorna true se há sobreposição, false caso contrário
+(inclusive se alguma forma for nula ou de tipo desconhecido)
+*/
+bool sobrepoe(Forma f1, Forma f2);
+
 
 /*                    FUNÇÕES ESPECIALISTAS DE SOBREPOSIÇÃO                    */
 /*
@@ -0,0 +1,403 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "sobreposicaoLote.h"
+
+#include "sobreposicao.h"
+#include "geometria.h"
+#include "circulo.h"
+#include "retangulo.h"
+
+#include <pthread.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TEM_X86 1
+#else
+#define TEM_X86 0
+#endif
+
+// pares agrupados por vez em sobrepoePares (os lotes ficam na pilha)
+#define BLOCO_LOTE 256
+
+static NivelSimd nivelAtual = SIMD_ESCALAR;
+static pthread_once_t nivelIniciado = PTHREAD_ONCE_INIT;
+
+
+/*________________________________ NÍVEL SIMD ________________________________*/
+
+NivelSimd nivelSimdSuportado() {
+#if TEM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#endif
+    return SIMD_ESCALAR;
+}
+
+NivelSimd nivelSimdPadrao() {
+    return (nivelSimdSuportado() == SIMD_AVX2) ? SIMD_AVX2 : SIMD_ESCALAR;
+}
+
+static void iniciaNivelSimd() {
+    nivelAtual = nivelSimdPadrao();
+}
+
+NivelSimd defineNivelSimd(NivelSimd nivel) {
+    pthread_once(&nivelIniciado, iniciaNivelSimd);
+    NivelSimd suportado = nivelSimdSuportado();
+    nivelAtual = (nivel > suportado) ? suportado : nivel;
+    return nivelAtual;
+}
+
+NivelSimd getNivelSimd() {
+    pthread_once(&nivelIniciado, iniciaNivelSimd);
+    return nivelAtual;
+}
+
+
+/*________________________________ NÚCLEOS ESCALARES ________________________________*/
+
+static void circuloCirculoEscalar(int inicio, int n,
+                                  const double *x1, const double *y1, const double *r1,
+                                  const double *x2, const double *y2, const double *r2,
+                                  bool *resultado) {
+    for (int k = inicio; k < n; k++) {
+        resultado[k] = intersecaoCirculoCirculo(x1[k], y1[k], r1[k], x2[k], y2[k], r2[k]);
+    }
+}
+
+static void circuloRetanguloEscalar(int inicio, int n,
+                                    const double *cx, const double *cy, const double *r,
+                                    const double *rx, const double *ry, const double *w, const double *h,
+                                    bool *resultado) {
+    for (int k = inicio; k < n; k++) {
+        resultado[k] = intersecaoCirculoRetangulo(cx[k], cy[k], r[k], rx[k], ry[k], w[k], h[k]);
+    }
+}
+
+static void retanguloRetanguloEscalar(int inicio, int n,
+                                      const double *x1, const double *y1, const double *w1, const double *h1,
+                                      const double *x2, const double *y2, const double *w2, const double *h2,
+                                      bool *resultado) {
+    for (int k = inicio; k < n; k++) {
+        resultado[k] = intersecaoRetanguloRetangulo(x1[k], y1[k], w1[k], h1[k], x2[k], y2[k], w2[k], h2[k]);
+    }
+}
+
+
+#if TEM_X86
+/*________________________________ NÚCLEOS SSE2 (2 pares por vez) ________________________________*/
+/*
+* As comparações do SSE2 (cmple/cmplt/cmpgt) são ordenadas: com NaN dão
+* falso, como os operadores do C. A escolha do ponto mais próximo do
+* retângulo segue a ordem dos 'if' de geometria.h (o teste cx < rx vale
+* por último, sobrescrevendo o cx > rx + w).
+*/
+
+// escolhe 'a' onde a máscara é verdadeira e 'b' nas outras posições
+__attribute__((target("sse2")))
+static __m128d selecionaSse2(__m128d mascara, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mascara, a), _mm_andnot_pd(mascara, b));
+}
+
+__attribute__((target("sse2")))
+static void gravaMascaraSse2(__m128d mascara, bool *resultado) {
+    int bits = _mm_movemask_pd(mascara);
+    resultado[0] = (bits & 1) != 0;
+    resultado[1] = (bits & 2) != 0;
+}
+
+__attribute__((target("sse2")))
+static int circuloCirculoSse2(int n,
+                              const double *x1, const double *y1, const double *r1,
+                              const double *x2, const double *y2, const double *r2,
+                              bool *resultado) {
+    int k = 0;
+    for (; k + 2 <= n; k += 2) {
+        __m128d somaRaios = _mm_add_pd(_mm_loadu_pd(r1 + k), _mm_loadu_pd(r2 + k));
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(x1 + k), _mm_loadu_pd(x2 + k));
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(y1 + k), _mm_loadu_pd(y2 + k));
+        __m128d dist = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        gravaMascaraSse2(_mm_cmple_pd(dist, _mm_mul_pd(somaRaios, somaRaios)), resultado + k);
+    }
+    return k;
+}
+
+__attribute__((target("sse2")))
+static int circuloRetanguloSse2(int n,
+                                const double *cx, const double *cy, const double *r,
+                                const double *rx, const double *ry, const double *w, const double *h,
+                                bool *resultado) {
+    int k = 0;
+    for (; k + 2 <= n; k += 2) {
+        __m128d vcx = _mm_loadu_pd(cx + k);
+        __m128d vcy = _mm_loadu_pd(cy + k);
+        __m128d vrx = _mm_loadu_pd(rx + k);
+        __m128d vry = _mm_loadu_pd(ry + k);
+        __m128d fimX = _mm_add_pd(vrx, _mm_loadu_pd(w + k));
+        __m128d fimY = _mm_add_pd(vry, _mm_loadu_pd(h + k));
+
+        __m128d px = selecionaSse2(_mm_cmpgt_pd(vcx, fimX), fimX, vcx);
+        px = selecionaSse2(_mm_cmplt_pd(vcx, vrx), vrx, px);
+        __m128d py = selecionaSse2(_mm_cmpgt_pd(vcy, fimY), fimY, vcy);
+        py = selecionaSse2(_mm_cmplt_pd(vcy, vry), vry, py);
+
+        __m128d dx = _mm_sub_pd(vcx, px);
+        __m128d dy = _mm_sub_pd(vcy, py);
+        __m128d dist = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        __m128d vr = _mm_loadu_pd(r + k);
+        gravaMascaraSse2(_mm_cmple_pd(dist, _mm_mul_pd(vr, vr)), resultado + k);
+    }
+    return k;
+}
+
+__attribute__((target("sse2")))
+static int retanguloRetanguloSse2(int n,
+                                  const double *x1, const double *y1, const double *w1, const double *h1,
+                                  const double *x2, const double *y2, const double *w2, const double *h2,
+                                  bool *resultado) {
+    int k = 0;
+    for (; k + 2 <= n; k += 2) {
+        __m128d vx1 = _mm_loadu_pd(x1 + k);
+        __m128d vy1 = _mm_loadu_pd(y1 + k);
+        __m128d vx2 = _mm_loadu_pd(x2 + k);
+        __m128d vy2 = _mm_loadu_pd(y2 + k);
+
+        __m128d sobreX = _mm_and_pd(_mm_cmplt_pd(vx1, _mm_add_pd(vx2, _mm_loadu_pd(w2 + k))),
+                                    _mm_cmpgt_pd(_mm_add_pd(vx1, _mm_loadu_pd(w1 + k)), vx2));
+        __m128d sobreY = _mm_and_pd(_mm_cmplt_pd(vy1, _mm_add_pd(vy2, _mm_loadu_pd(h2 + k))),
+                                    _mm_cmpgt_pd(_mm_add_pd(vy1, _mm_loadu_pd(h1 + k)), vy2));
+        gravaMascaraSse2(_mm_and_pd(sobreX, sobreY), resultado + k);
+    }
+    return k;
+}
+
+
+/*________________________________ NÚCLEOS AVX2 (4 pares por vez) ________________________________*/
+/*
+* Mesmas contas dos núcleos SSE2. Os predicados _OQ (ordenados, sem sinal
+* de exceção) reproduzem os operadores do C com NaN. Nada de FMA: a
+* multiplicação e a soma são arredondadas separadamente, como no escalar.
+*/
+
+__attribute__((target("avx2")))
+static void gravaMascaraAvx2(__m256d mascara, bool *resultado) {
+    int bits = _mm256_movemask_pd(mascara);
+    resultado[0] = (bits & 1) != 0;
+    resultado[1] = (bits & 2) != 0;
+    resultado[2] = (bits & 4) != 0;
+    resultado[3] = (bits & 8) != 0;
+}
+
+__attribute__((target("avx2")))
+static int circuloCirculoAvx2(int n,
+                              const double *x1, const double *y1, const double *r1,
+                              const double *x2, const double *y2, const double *r2,
+                              bool *resultado) {
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d somaRaios = _mm256_add_pd(_mm256_loadu_pd(r1 + k), _mm256_loadu_pd(r2 + k));
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x1 + k), _mm256_loadu_pd(x2 + k));
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y1 + k), _mm256_loadu_pd(y2 + k));
+        __m256d dist = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        gravaMascaraAvx2(_mm256_cmp_pd(dist, _mm256_mul_pd(somaRaios, somaRaios), _CMP_LE_OQ),
+                         resultado + k);
+    }
+    return k;
+}
+
+__attribute__((target("avx2")))
+static int circuloRetanguloAvx2(int n,
+                                const double *cx, const double *cy, const double *r,
+                                const double *rx, const double *ry, const double *w, const double *h,
+                                bool *resultado) {
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d vcx = _mm256_loadu_pd(cx + k);
+        __m256d vcy = _mm256_loadu_pd(cy + k);
+        __m256d vrx = _mm256_loadu_pd(rx + k);
+        __m256d vry = _mm256_loadu_pd(ry + k);
+        __m256d fimX = _mm256_add_pd(vrx, _mm256_loadu_pd(w + k));
+        __m256d fimY = _mm256_add_pd(vry, _mm256_loadu_pd(h + k));
+
+        __m256d px = _mm256_blendv_pd(vcx, fimX, _mm256_cmp_pd(vcx, fimX, _CMP_GT_OQ));
+        px = _mm256_blendv_pd(px, vrx, _mm256_cmp_pd(vcx, vrx, _CMP_LT_OQ));
+        __m256d py = _mm256_blendv_pd(vcy, fimY, _mm256_cmp_pd(vcy, fimY, _CMP_GT_OQ));
+        py = _mm256_blendv_pd(py, vry, _mm256_cmp_pd(vcy, vry, _CMP_LT_OQ));
+
+        __m256d dx = _mm256_sub_pd(vcx, px);
+        __m256d dy = _mm256_sub_pd(vcy, py);
+        __m256d dist = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        __m256d vr = _mm256_loadu_pd(r + k);
+        gravaMascaraAvx2(_mm256_cmp_pd(dist, _mm256_mul_pd(vr, vr), _CMP_LE_OQ), resultado + k);
+    }
+    return k;
+}
+
+__attribute__((target("avx2")))
+static int retanguloRetanguloAvx2(int n,
+                                  const double *x1, const double *y1, const double *w1, const double *h1,
+                                  const double *x2, const double *y2, const double *w2, const double *h2,
+                                  bool *resultado) {
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d vx1 = _mm256_loadu_pd(x1 + k);
+        __m256d vy1 = _mm256_loadu_pd(y1 + k);
+        __m256d vx2 = _mm256_loadu_pd(x2 + k);
+        __m256d vy2 = _mm256_loadu_pd(y2 + k);
+
+        __m256d sobreX = _mm256_and_pd(
+            _mm256_cmp_pd(vx1, _mm256_add_pd(vx2, _mm256_loadu_pd(w2 + k)), _CMP_LT_OQ),
+            _mm256_cmp_pd(_mm256_add_pd(vx1, _mm256_loadu_pd(w1 + k)), vx2, _CMP_GT_OQ));
+        __m256d sobreY = _mm256_and_pd(
+            _mm256_cmp_pd(vy1, _mm256_add_pd(vy2, _mm256_loadu_pd(h2 + k)), _CMP_LT_OQ),
+            _mm256_cmp_pd(_mm256_add_pd(vy1, _mm256_loadu_pd(h1 + k)), vy2, _CMP_GT_OQ));
+        gravaMascaraAvx2(_mm256_and_pd(sobreX, sobreY), resultado + k);
+    }
+    return k;
+}
+#endif
+
+
+/*________________________________ DESPACHO DOS NÚCLEOS ________________________________*/
+// o núcleo vetorial cobre os múltiplos da largura; o resto vai no escalar
+
+void sobrepoeLoteCirculoCirculo(int n,
+                                const double *x1, const double *y1, const double *r1,
+                                const double *x2, const double *y2, const double *r2,
+                                bool *resultado) {
+    int feitos = 0;
+#if TEM_X86
+    switch (getNivelSimd()) {
+        case SIMD_AVX2: feitos = circuloCirculoAvx2(n, x1, y1, r1, x2, y2, r2, resultado); break;
+        case SIMD_SSE2: feitos = circuloCirculoSse2(n, x1, y1, r1, x2, y2, r2, resultado); break;
+        default: break;
+    }
+#endif
+    circuloCirculoEscalar(feitos, n, x1, y1, r1, x2, y2, r2, resultado);
+}
+
+void sobrepoeLoteCirculoRetangulo(int n,
+                                  const double *cx, const double *cy, const double *r,
+                                  const double *rx, const double *ry, const double *w, const double *h,
+                                  bool *resultado) {
+    int feitos = 0;
+#if TEM_X86
+    switch (getNivelSimd()) {
+        case SIMD_AVX2: feitos = circuloRetanguloAvx2(n, cx, cy, r, rx, ry, w, h, resultado); break;
+        case SIMD_SSE2: feitos = circuloRetanguloSse2(n, cx, cy, r, rx, ry, w, h, resultado); break;
+        default: break;
+    }
+#endif
+    circuloRetanguloEscalar(feitos, n, cx, cy, r, rx, ry, w, h, resultado);
+}
+
+void sobrepoeLoteRetanguloRetangulo(int n,
+                                    const double *x1, const double *y1, const double *w1, const double *h1,
+                                    const double *x2, const double *y2, const double *w2, const double *h2,
+                                    bool *resultado) {
+    int feitos = 0;
+#if TEM_X86
+    switch (getNivelSimd()) {
+        case SIMD_AVX2: feitos = retanguloRetanguloAvx2(n, x1, y1, w1, h1, x2, y2, w2, h2, resultado); break;
+        case SIMD_SSE2: feitos = retanguloRetanguloSse2(n, x1, y1, w1, h1, x2, y2, w2, h2, resultado); break;
+        default: break;
+    }
+#endif
+    retanguloRetanguloEscalar(feitos, n, x1, y1, w1, h1, x2, y2, w2, h2, resultado);
+}
+
+
+/*________________________________ AGRUPAMENTO POR TIPO ________________________________*/
+
+// lotes de um bloco: coordenadas por par e o índice do par no bloco
+typedef struct {
+    int n;
+    int par[BLOCO_LOTE];
+    bool resultado[BLOCO_LOTE];
+    double x1[BLOCO_LOTE], y1[BLOCO_LOTE], r1[BLOCO_LOTE];
+    double x2[BLOCO_LOTE], y2[BLOCO_LOTE], r2[BLOCO_LOTE];
+} LoteCirculoCirculo;
+
+typedef struct {
+    int n;
+    int par[BLOCO_LOTE];
+    bool resultado[BLOCO_LOTE];
+    double cx[BLOCO_LOTE], cy[BLOCO_LOTE], r[BLOCO_LOTE];
+    double rx[BLOCO_LOTE], ry[BLOCO_LOTE], w[BLOCO_LOTE], h[BLOCO_LOTE];
+} LoteCirculoRetangulo;
+
+typedef struct {
+    int n;
+    int par[BLOCO_LOTE];
+    bool resultado[BLOCO_LOTE];
+    double x1[BLOCO_LOTE], y1[BLOCO_LOTE], w1[BLOCO_LOTE], h1[BLOCO_LOTE];
+    double x2[BLOCO_LOTE], y2[BLOCO_LOTE], w2[BLOCO_LOTE], h2[BLOCO_LOTE];
+} LoteRetanguloRetangulo;
+
+static void adicionaCirculoCirculo(LoteCirculoCirculo *l, int par, Circulo c1, Circulo c2) {
+    int k = l->n++;
+    l->par[k] = par;
+    l->x1[k] = getXCirculo(c1); l->y1[k] = getYCirculo(c1); l->r1[k] = getRCirculo(c1);
+    l->x2[k] = getXCirculo(c2); l->y2[k] = getYCirculo(c2); l->r2[k] = getRCirculo(c2);
+}
+
+static void adicionaCirculoRetangulo(LoteCirculoRetangulo *l, int par, Circulo c, Retangulo r) {
+    int k = l->n++;
+    l->par[k] = par;
+    l->cx[k] = getXCirculo(c); l->cy[k] = getYCirculo(c); l->r[k] = getRCirculo(c);
+    l->rx[k] = getXRetangulo(r); l->ry[k] = getYRetangulo(r);
+    l->w[k] = getLarguraRetangulo(r); l->h[k] = getAlturaRetangulo(r);
+}
+
+static void adicionaRetanguloRetangulo(LoteRetanguloRetangulo *l, int par, Retangulo r1, Retangulo r2) {
+    int k = l->n++;
+    l->par[k] = par;
+    l->x1[k] = getXRetangulo(r1); l->y1[k] = getYRetangulo(r1);
+    l->w1[k] = getLarguraRetangulo(r1); l->h1[k] = getAlturaRetangulo(r1);
+    l->x2[k] = getXRetangulo(r2); l->y2[k] = getYRetangulo(r2);
+    l->w2[k] = getLarguraRetangulo(r2); l->h2[k] = getAlturaRetangulo(r2);
+}
+
+void sobrepoePares(const Forma *formas, int numPares, bool *resultado) {
+    LoteCirculoCirculo cc;
+    LoteCirculoRetangulo cr;
+    LoteRetanguloRetangulo rr;
+
+    for (int base = 0; base < numPares; base += BLOCO_LOTE) {
+        int fim = (numPares - base < BLOCO_LOTE) ? numPares : base + BLOCO_LOTE;
+        cc.n = 0;
+        cr.n = 0;
+        rr.n = 0;
+
+        // separa os pares do bloco por combinação de tipos
+        for (int p = base; p < fim; p++) {
+            Forma fI = formas[2 * p];
+            Forma fJ = formas[2 * p + 1];
+            TipoForma tI = getFormaTipo(fI);
+            TipoForma tJ = getFormaTipo(fJ);
+
+            if (tI == TIPO_CIRCULO && tJ == TIPO_CIRCULO) {
+                adicionaCirculoCirculo(&cc, p, getFormaAssoc(fI), getFormaAssoc(fJ));
+            } else if (tI == TIPO_CIRCULO && tJ == TIPO_RETANGULO) {
+                adicionaCirculoRetangulo(&cr, p, getFormaAssoc(fI), getFormaAssoc(fJ));
+            } else if (tI == TIPO_RETANGULO && tJ == TIPO_CIRCULO) {
+                adicionaCirculoRetangulo(&cr, p, getFormaAssoc(fJ), getFormaAssoc(fI));
+            } else if (tI == TIPO_RETANGULO && tJ == TIPO_RETANGULO) {
+                adicionaRetanguloRetangulo(&rr, p, getFormaAssoc(fI), getFormaAssoc(fJ));
+            } else {
+                resultado[p] = sobrepoe(fI, fJ);
+            }
+        }
+
+        sobrepoeLoteCirculoCirculo(cc.n, cc.x1, cc.y1, cc.r1, cc.x2, cc.y2, cc.r2, cc.resultado);
+        sobrepoeLoteCirculoRetangulo(cr.n, cr.cx, cr.cy, cr.r, cr.rx, cr.ry, cr.w, cr.h, cr.resultado);
+        sobrepoeLoteRetanguloRetangulo(rr.n, rr.x1, rr.y1, rr.w1, rr.h1,
+                                       rr.x2, rr.y2, rr.w2, rr.h2, rr.resultado);
+
+        // devolve os veredictos às posições originais dos pares
+        for (int k = 0; k < cc.n; k++) resultado[cc.par[k]] = cc.resultado[k];
+        for (int k = 0; k < cr.n; k++) resultado[cr.par[k]] = cr.resultado[k];
+        for (int k = 0; k < rr.n; k++) resultado[rr.par[k]] = rr.resultado[k];
+    }
+}
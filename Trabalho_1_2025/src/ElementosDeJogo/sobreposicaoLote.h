@@ -0,0 +1,91 @@
+#ifndef SOBREPOSICAOLOTE_H
+#define SOBREPOSICAOLOTE_H
+
+#include <stdbool.h>
+
+#include "formas.h"
+
+/*
+*        SOBREPOSIÇÃO EM LOTE
+*
+*        Avalia muitos pares de formas de uma vez. Os pares círculo-círculo,
+*        círculo-retângulo e retângulo-retângulo são separados por tipo em
+*        lotes no formato "estrutura de vetores" (um vetor por coordenada)
+*        e testados por núcleos vetoriais (AVX2, escolhido em tempo de
+*        execução conforme a CPU; SSE2 só quando pedido); os demais pares
+*        passam por sobrepoe().
+*
+*        Os núcleos fazem exatamente as mesmas operações de ponto flutuante
+*        de geometria.h, na mesma ordem e sem FMA, então o resultado é sempre
+*        igual ao de sobrepoe() para cada par.
+*/
+
+// conjunto de instruções usado pelos núcleos vetoriais
+typedef enum {
+    SIMD_ESCALAR = 0,
+    SIMD_SSE2 = 1,
+    SIMD_AVX2 = 2
+} NivelSimd;
+
+/*
+Retorna o nível mais alto suportado pela CPU em que o programa está rodando.
+*/
+NivelSimd nivelSimdSuportado();
+
+/*
+Retorna o nível usado quando nada é pedido: AVX2 se a CPU o tiver e, senão,
+o escalar. Com as flags do makefile (-O0) o núcleo SSE2 de 2 pares por vez
+não ganha do escalar (bench: ~31-34 contra ~31 ns/par em círculo-retângulo),
+então ele só é usado se pedido em defineNivelSimd.
+*/
+NivelSimd nivelSimdPadrao();
+
+/*
+Escolhe o nível usado pelos núcleos (o padrão é o de nivelSimdPadrao).
+Pedidos acima do suportado são rebaixados para ele. Não deve ser chamado
+enquanto outra thread avalia lotes.
+*
+* Pós-condição: retorna o nível efetivamente escolhido
+*/
+NivelSimd defineNivelSimd(NivelSimd nivel);
+
+// Retorna o nível usado atualmente pelos núcleos
+NivelSimd getNivelSimd();
+
+/*
+Verifica a sobreposição de 'numPares' pares de formas adjacentes: o par p
+é (formas[2p], formas[2p+1]).
+
+* formas: vetor com 2 * numPares formas válidas
+* resultado: recebe, para cada par, o mesmo valor de sobrepoe()
+*
+* Pré-condição: os vetores devem ter o tamanho indicado
+* Pós-condição: resultado[p] preenchido para todo p; não aloca memória e
+* só lê as formas, então faixas diferentes podem rodar em threads diferentes
+*/
+void sobrepoePares(const Forma *formas, int numPares, bool *resultado);
+
+
+/*________________________ NÚCLEOS (vetores de coordenadas) ________________________*/
+/*
+* Cada função testa os pares k = 0 .. n-1, lendo a coordenada k de cada
+* vetor (mesmas convenções de geometria.h), e grava resultado[k].
+* Usam o nível escolhido em defineNivelSimd.
+*/
+
+void sobrepoeLoteCirculoCirculo(int n,
+                                const double *x1, const double *y1, const double *r1,
+                                const double *x2, const double *y2, const double *r2,
+                                bool *resultado);
+
+void sobrepoeLoteCirculoRetangulo(int n,
+                                  const double *cx, const double *cy, const double *r,
+                                  const double *rx, const double *ry, const double *w, const double *h,
+                                  bool *resultado);
+
+void sobrepoeLoteRetanguloRetangulo(int n,
+                                    const double *x1, const double *y1, const double *w1, const double *h1,
+                                    const double *x2, const double *y2, const double *w2, const double *h2,
+                                    bool *resultado);
+
+#endif
@@ -1,20 +1,49 @@
 #include "fila.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-// nó interno da fila
-typedef struct aux {
-    Item item;
-    struct aux *prox;
-} AUX;
+// capacidade do primeiro vetor alocado (sempre potência de 2)
+#define CAPACIDADE_INICIAL 16
 
-// estrutura da fila
+// estrutura da fila: vetor circular que dobra de tamanho quando enche
 typedef struct queue {
-    AUX *first;
-    AUX *last;
+    Item *itens;     // vetor circular (alocado no primeiro enfileira)
+    int capacidade;  // tamanho do vetor, potência de 2
+    int inicio;      // índice do primeiro elemento
     int size;
 } filaC;
 
+// índice real da posição 'i' a partir do início (capacidade é potência de 2)
+static int posicaoFila(const filaC *f, int i) {
+    return (f->inicio + i) & (f->capacidade - 1);
+}
+
+// dobra a capacidade do vetor até caber pelo menos 'minimo' elementos,
+// mantendo a ordem dos elementos
+static void cresceFila(filaC *f, int minimo) {
+    int capacidadeAntiga = f->capacidade;
+    int novaCapacidade = (capacidadeAntiga == 0) ? CAPACIDADE_INICIAL : capacidadeAntiga * 2;
+    while (novaCapacidade < minimo) {
+        novaCapacidade *= 2;
+    }
+
+    Item *novo = (Item*) realloc(f->itens, novaCapacidade * sizeof(Item));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+
+    // se a fila dava a volta no vetor, os elementos do começo passam para
+    // logo depois do fim antigo (cabem, pois a capacidade ao menos dobrou)
+    for (int i = 0; i < f->inicio; i++) {
+        novo[capacidadeAntiga + i] = novo[i];
+    }
+
+    f->itens = novo;
+    f->capacidade = novaCapacidade;
+}
+
 // cria uma fila vazia
 Queue createQueue() {
     filaC *f = (filaC*) malloc(sizeof(filaC));
@@ -22,8 +51,9 @@ Queue createQueue() {
         printf("Erro: falha na alocação de memória.\n");
         exit(1);
     }
-    f->first = NULL;
-    f->last = NULL;
+    f->itens = NULL;
+    f->capacidade = 0;
+    f->inicio = 0;
     f->size = 0;
     return (Queue) f;
 }
@@ -31,57 +61,85 @@ Queue createQueue() {
 // insere no final
 void enfileira(Queue q, Item i) {
     filaC *f = (filaC*) q;
-    AUX *novo = (AUX*) malloc(sizeof(AUX));
-    if (novo == NULL) {
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    novo->item = i;
-    novo->prox = NULL;
-    
-    if (f->size == 0) {
-        f->first = novo;
-        f->last = novo;
-    } else {
-        f->last->prox = novo;
-        f->last = novo;
+    if (f->size == f->capacidade) {
+        cresceFila(f, f->size + 1);
     }
+    f->itens[posicaoFila(f, f->size)] = i;
     f->size++;
 }
 
+// insere n elementos no final, na ordem do vetor
+void enfileiraVetor(Queue q, Item *itens, int n) {
+    filaC *f = (filaC*) q;
+    if (n <= 0) {
+        return;
+    }
+    if (f->capacidade - f->size < n) {
+        cresceFila(f, f->size + n);
+    }
+
+    // copia em até dois trechos contíguos (antes e depois da volta do vetor)
+    int fim = posicaoFila(f, f->size);
+    int primeiroTrecho = f->capacidade - fim;
+    if (primeiroTrecho > n) {
+        primeiroTrecho = n;
+    }
+    memcpy(&f->itens[fim], itens, primeiroTrecho * sizeof(Item));
+    memcpy(f->itens, itens + primeiroTrecho, (n - primeiroTrecho) * sizeof(Item));
+    f->size += n;
+}
+
 // remove o primeiro elemento e retorna
 Item desenfileira(Queue q) {
     filaC *f = (filaC*) q;
     if (f->size == 0) {
         return NULL;
     }
-    AUX *temp = f->first;
-    Item info = temp->item;
-    f->first = f->first->prox;
-    if (f->first == NULL) {
-        f->last = NULL;
-    }
-    free(temp);
+    Item info = f->itens[f->inicio];
+    f->inicio = posicaoFila(f, 1);
     f->size--;
     return info;
 }
 
+// remove os n primeiros elementos, gravando-os em ordem no vetor
+int desenfileiraVetor(Queue q, Item *destino, int n) {
+    filaC *f = (filaC*) q;
+    if (n > f->size) {
+        n = f->size;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+
+    // copia em até dois trechos contíguos (antes e depois da volta do vetor)
+    int primeiroTrecho = f->capacidade - f->inicio;
+    if (primeiroTrecho > n) {
+        primeiroTrecho = n;
+    }
+    memcpy(destino, &f->itens[f->inicio], primeiroTrecho * sizeof(Item));
+    memcpy(destino + primeiroTrecho, f->itens, (n - primeiroTrecho) * sizeof(Item));
+
+    f->inicio = posicaoFila(f, n);
+    f->size -= n;
+    return n;
+}
+
 // retorna o primeiro elemento sem remover
 Item inicioFila(const Queue q) {
     filaC *f = (filaC*) q;
-    if (f->first == NULL) {
+    if (f->size == 0) {
         return NULL;
     }
-    return f->first->item;
+    return f->itens[f->inicio];
 }
 
 // retorna o último elemento sem remover
 Item fimFila(const Queue q) {
     filaC *f = (filaC*) q;
-    if (f->last == NULL) {
+    if (f->size == 0) {
         return NULL;
     }
-    return f->last->item;
+    return f->itens[posicaoFila(f, f->size - 1)];
 }
 
 // verifica se a fila está vazia
@@ -100,17 +158,32 @@ int getTamanhoFila(const Queue q) {
     return f->size;
 }
 
+// retorna o elemento da posição indicada sem remover
+Item getItemFila(const Queue q, int posicao) {
+    filaC *f = (filaC*) q;
+    if (f == NULL || posicao < 0 || posicao >= f->size) {
+        return NULL;
+    }
+    return f->itens[posicaoFila(f, posicao)];
+}
+
+// percorre a fila do início ao fim sem alterá-la
+void iteraFila(const Queue q, void (*executa)(Item i, void *auxData), void *auxData) {
+    filaC *f = (filaC*) q;
+    if (f == NULL || executa == NULL) {
+        return;
+    }
+    for (int i = 0; i < f->size; i++) {
+        executa(f->itens[posicaoFila(f, i)], auxData);
+    }
+}
+
 // libera toda a fila
 void destroiFila(Queue q) {
     if (q == NULL) {
         return;
     }
     filaC *f = (filaC*) q;
-    AUX *atual = f->first;
-    while (atual != NULL) {
-        AUX *prox = atual->prox;
-        free(atual);
-        atual = prox;
-    }
+    free(f->itens);
     free(f);
-}
\ No newline at end of file
+}
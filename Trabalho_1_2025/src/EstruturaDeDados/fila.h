@@ -13,7 +13,9 @@
  A Fila é essencial para o controle de processos e gerenciamento de tarefas.
 
  O TAD é implementado utilizando ponteiros opacos (void *), ocultando
- a representação interna da estrutura.
+ a representação interna da estrutura. Internamente a fila é um vetor
+ circular que dobra de capacidade quando enche, assim enfileirar e
+ desenfileirar não alocam memória a cada operação.
 */
 
 
@@ -51,11 +53,24 @@ Queue createQueue();
  q: ponteiro para a fila
  i: o item que sera enfileirado
 
- A fila não deve estar cheia 
+ A fila deve estar inicializada (ela cresce sozinha quando cheia)
  A fila conterá o novo elemento em seu final após este procedimento
 */
 void enfileira(Queue q, Item i);
 
+/*
+  Insere n elementos no final da fila, na ordem em que estão no vetor.
+
+ q: ponteiro para a fila
+ itens: vetor com os itens a serem enfileirados
+ n: quantidade de itens
+
+ A fila deve estar inicializada
+ O resultado é o mesmo de n chamadas a enfileira, mas a fila cresce no
+ máximo uma vez e os itens são copiados em bloco
+*/
+void enfileiraVetor(Queue q, Item *itens, int n);
+
 /*
 Retira o elemento do início da fila.
 
@@ -66,6 +81,19 @@ Retira o elemento do início da fila.
 */
 Item desenfileira(Queue q); 
 
+/*
+Retira os n primeiros elementos da fila e os grava em um vetor, na ordem
+em que desenfileira os retornaria.
+
+ q: ponteiro para a fila
+ destino: vetor com espaço para pelo menos n itens
+ n: quantidade de elementos (limitada ao tamanho da fila)
+
+ A fila deve estar inicializada
+ Retorna quantos elementos foram retirados.
+*/
+int desenfileiraVetor(Queue q, Item *destino, int n);
+
 /*
 Retornar o elemento do início da fila
 
@@ -107,6 +135,32 @@ Retorna o número de elementos atualmente na Fila.
 */
 int getTamanhoFila(const Queue q);
 
+/*
+Retorna o elemento na posição 'posicao' da fila, sem removê-lo.
+A posição 0 é o início da fila e getTamanhoFila(q) - 1 é o final.
+
+ q: ponteiro para a fila
+ posicao: índice do elemento a partir do início
+
+ A fila deve estar inicializada
+ Retorna o elemento da posição, ou NULL se a posição for inválida.
+*/
+Item getItemFila(const Queue q, int posicao);
+
+/*
+Percorre a fila do início ao final, executando uma função para cada
+elemento. A fila não é alterada: nenhum elemento é removido ou reinserido.
+
+ q: ponteiro para a fila
+ executa: função chamada para cada elemento, recebendo o item e 'auxData'
+ auxData: ponteiro para dados extras repassado a 'executa'
+
+ A fila deve estar inicializada e 'executa' não deve inserir nem remover
+ elementos da própria fila
+ A função 'executa' é aplicada a cada elemento, na ordem FIFO.
+*/
+void iteraFila(const Queue q, void (*executa)(Item i, void *auxData), void *auxData);
+
 /*
 Libera toda a memória alocada para a Fila.
 
@@ -2,18 +2,33 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-// nó interno da pilha
-typedef struct aux {
-    Item item;
-    struct aux *prox;
-} AUX;
+// capacidade do primeiro vetor alocado
+#define CAPACIDADE_INICIAL 16
 
-// estrutura da pilha
+// estrutura da pilha: vetor contíguo que dobra de tamanho quando enche,
+// o topo é sempre a posição size - 1
 typedef struct stack {
-    AUX *top;    
-    int size;    // NOVO: contador de elementos
+    Item *itens;     // alocado no primeiro empilha
+    int capacidade;
+    int size;        // contador de elementos
 } pilhaC;
 
+// dobra a capacidade do vetor até caber pelo menos 'minimo' elementos
+static void crescePilha(pilhaC *pilha, int minimo) {
+    int novaCapacidade = (pilha->capacidade == 0) ? CAPACIDADE_INICIAL : pilha->capacidade * 2;
+    while (novaCapacidade < minimo) {
+        novaCapacidade *= 2;
+    }
+
+    Item *novo = (Item*) realloc(pilha->itens, novaCapacidade * sizeof(Item));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    pilha->itens = novo;
+    pilha->capacidade = novaCapacidade;
+}
+
 // cria uma pilha vazia
 Stack createStk() {
     pilhaC *p = (pilhaC*) malloc(sizeof(pilhaC));
@@ -21,7 +36,8 @@ Stack createStk() {
         printf("Erro: falha na alocação de memória.\n");
         exit(1);
     }
-    p->top = NULL;
+    p->itens = NULL;
+    p->capacidade = 0;
     p->size = 0;
     return (Stack) p;
 }
@@ -29,14 +45,10 @@ Stack createStk() {
 // insere no topo
 void empilha(Stack p, Item i) {
     pilhaC *pilha = (pilhaC*) p;
-    AUX *novo = (AUX*) malloc(sizeof(AUX));
-    if (novo == NULL) {
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
+    if (pilha->size == pilha->capacidade) {
+        crescePilha(pilha, pilha->size + 1);
     }
-    novo->item = i;
-    novo->prox = pilha->top;  
-    pilha->top = novo;        
+    pilha->itens[pilha->size] = i;
     pilha->size++;  // ATUALIZA contador
 }
 
@@ -46,21 +58,17 @@ Item desempilha(Stack p) {
     if (pilha->size == 0) {
         return NULL;  
     }
-    AUX *temp = pilha->top;
-    Item info = temp->item;
-    pilha->top = pilha->top->prox;  
-    free(temp);
     pilha->size--;  // ATUALIZA contador
-    return info;
+    return pilha->itens[pilha->size];
 }
 
 // retorna o elemento do topo sem remover
 Item topoPilha(Stack p) {
     pilhaC *pilha = (pilhaC*) p;
-    if (pilha->top == NULL) {
+    if (pilha->size == 0) {
         return NULL;
     }
-    return pilha->top->item;
+    return pilha->itens[pilha->size - 1];
 }
 
 // verifica se a pilha está vazia
@@ -77,14 +85,45 @@ int getTamanhoPilha(Stack p) {
     return pilha->size;
 }
 
+// move os k elementos do topo da origem para o destino, invertendo a ordem
+void transferePilha(Stack origem, Stack destino, int k) {
+    pilhaC *o = (pilhaC*) origem;
+    pilhaC *d = (pilhaC*) destino;
+    if (o == d || k <= 0) {
+        return;
+    }
+    if (k > o->size) {
+        k = o->size;
+    }
+    if (d->capacidade - d->size < k) {
+        crescePilha(d, d->size + k);
+    }
+    for (int i = 0; i < k; i++) {
+        d->itens[d->size + i] = o->itens[o->size - 1 - i];
+    }
+    d->size += k;
+    o->size -= k;
+}
+
+// retira os k elementos do topo, gravando-os na ordem de desempilha
+int desempilhaVetor(Stack p, Item *destino, int k) {
+    pilhaC *pilha = (pilhaC*) p;
+    if (k <= 0) {
+        return 0;
+    }
+    if (k > pilha->size) {
+        k = pilha->size;
+    }
+    for (int i = 0; i < k; i++) {
+        destino[i] = pilha->itens[pilha->size - 1 - i];
+    }
+    pilha->size -= k;
+    return k;
+}
+
 // libera toda a pilha
 void destroiPilha(Stack p) {
     pilhaC *pilha = (pilhaC*) p;
-    AUX *atual = pilha->top;
-    while (atual != NULL) {
-        AUX *prox = atual->prox;
-        free(atual);
-        atual = prox;
-    }
+    free(pilha->itens);
     free(pilha);
-}
\ No newline at end of file
+}
@@ -12,7 +12,9 @@
  A Pilha é essencial para o funcionamento dos carregadores (Launchers).
 
  O TAD é implementado utilizando ponteiros opacos (void *), ocultando
- a representação interna da estrutura.
+ a representação interna da estrutura. Internamente a pilha é um vetor
+ contíguo que dobra de capacidade quando enche, assim empilhar e
+ desempilhar não alocam memória a cada operação.
 */
 
 
@@ -51,7 +53,7 @@ Stack createStk();
  p: ponteiro para a pilha
  i: o item que sera empilhado
 
- A pilha não deve estar cheia 
+ A pilha deve estar inicializada (ela cresce sozinha quando cheia)
  A pilha conterá o novo elemento em seu topo após este procedimento
  */
 void empilha(Stack p, Item i);
@@ -87,6 +89,34 @@ Retornará um valor mostrando a quantidade de elementos da pilha.
 */
 int getTamanhoPilha(Stack p);
 
+/*
+Move os k elementos do topo de uma pilha para o topo de outra, um a um,
+com o mesmo resultado de k pares desempilha/empilha: o topo da origem é o
+primeiro a ser empilhado no destino, então a ordem fica invertida.
+
+origem: pilha de onde os elementos saem
+destino: pilha que recebe os elementos
+k: quantidade de elementos (limitada ao tamanho da origem)
+
+As duas pilhas devem estar inicializadas
+O destino cresce no máximo uma vez; se origem e destino forem a mesma
+pilha nada muda, como na sequência equivalente de desempilha/empilha.
+*/
+void transferePilha(Stack origem, Stack destino, int k);
+
+/*
+Retira os k elementos do topo da pilha e os grava em um vetor, na ordem
+em que desempilha os retornaria (o topo vai para a posição 0).
+
+p: ponteiro para a pilha
+destino: vetor com espaço para pelo menos k itens
+k: quantidade de elementos (limitada ao tamanho da pilha)
+
+A pilha deve estar inicializada
+Retorna quantos elementos foram retirados.
+*/
+int desempilhaVetor(Stack p, Item *destino, int k);
+
 /**
  Verifica se a Pilha está vazia.
 
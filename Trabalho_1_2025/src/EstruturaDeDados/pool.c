@@ -0,0 +1,122 @@
+#include "pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// alinhamento dos objetos entregues (suficiente para double e ponteiros)
+#define ALINHAMENTO 16
+
+// cabeçalho de cada bloco pedido ao sistema; os objetos vêm logo depois
+typedef union bloco {
+    union bloco *prox;
+    char alinhamento[ALINHAMENTO];
+} BlocoPool;
+
+// um objeto liberado guarda, no próprio espaço, o próximo livre
+typedef struct livre {
+    struct livre *prox;
+} ObjetoLivre;
+
+// estrutura do pool
+typedef struct pool {
+    size_t tamanhoObjeto;  // já arredondado para o alinhamento
+    int objetosPorBloco;
+    BlocoPool *blocos;     // lista de todos os blocos, para liberar no fim
+    char *proximo;         // próximo objeto ainda não entregue do bloco atual
+    char *fimBloco;
+    ObjetoLivre *livres;
+    int emUso;
+} poolC;
+
+// cria um pool vazio (o primeiro bloco só é pedido na primeira alocação)
+Pool criaPool(size_t tamanhoObjeto, int objetosPorBloco) {
+    if (tamanhoObjeto == 0 || objetosPorBloco <= 0) {
+        return NULL;
+    }
+
+    poolC *p = (poolC*) malloc(sizeof(poolC));
+    if (p == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+
+    if (tamanhoObjeto < sizeof(ObjetoLivre)) {
+        tamanhoObjeto = sizeof(ObjetoLivre);
+    }
+    p->tamanhoObjeto = (tamanhoObjeto + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO;
+    p->objetosPorBloco = objetosPorBloco;
+    p->blocos = NULL;
+    p->proximo = NULL;
+    p->fimBloco = NULL;
+    p->livres = NULL;
+    p->emUso = 0;
+    return (Pool) p;
+}
+
+// pede um novo bloco ao sistema e passa a entregar objetos dele
+static void novoBlocoPool(poolC *p) {
+    size_t tamanhoDados = p->tamanhoObjeto * (size_t) p->objetosPorBloco;
+    BlocoPool *bloco = (BlocoPool*) malloc(sizeof(BlocoPool) + tamanhoDados);
+    if (bloco == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    bloco->prox = p->blocos;
+    p->blocos = bloco;
+    p->proximo = (char*) (bloco + 1);
+    p->fimBloco = p->proximo + tamanhoDados;
+}
+
+// entrega um objeto: primeiro reaproveita livres, depois avança no bloco
+void *alocaObjetoPool(Pool pl) {
+    poolC *p = (poolC*) pl;
+    void *obj;
+
+    if (p->livres != NULL) {
+        obj = p->livres;
+        p->livres = p->livres->prox;
+    } else {
+        if (p->proximo == p->fimBloco) {
+            novoBlocoPool(p);
+        }
+        obj = p->proximo;
+        p->proximo += p->tamanhoObjeto;
+    }
+
+    p->emUso++;
+    return obj;
+}
+
+// devolve o objeto para a lista de livres
+void liberaObjetoPool(Pool pl, void *obj) {
+    if (pl == NULL || obj == NULL) {
+        return;
+    }
+    poolC *p = (poolC*) pl;
+    ObjetoLivre *livre = (ObjetoLivre*) obj;
+    livre->prox = p->livres;
+    p->livres = livre;
+    p->emUso--;
+}
+
+int getObjetosEmUsoPool(const Pool pl) {
+    if (pl == NULL) {
+        return 0;
+    }
+    poolC *p = (poolC*) pl;
+    return p->emUso;
+}
+
+// libera todos os blocos de uma vez
+void destroiPool(Pool pl) {
+    if (pl == NULL) {
+        return;
+    }
+    poolC *p = (poolC*) pl;
+    BlocoPool *atual = p->blocos;
+    while (atual != NULL) {
+        BlocoPool *prox = atual->prox;
+        free(atual);
+        atual = prox;
+    }
+    free(p);
+}
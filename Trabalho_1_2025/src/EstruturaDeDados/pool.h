@@ -0,0 +1,91 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/*
+ TIPO ABSTRATO DE DADOS: POOL DE OBJETOS
+
+ Este módulo define a interface de um Pool, um alocador de objetos de
+ tamanho fixo. A memória é pedida ao sistema em blocos grandes e os
+ objetos são entregues em sequência dentro do bloco atual (alocação por
+ avanço de ponteiro). Objetos liberados vão para uma lista de livres e
+ são reaproveitados pelas próximas alocações.
+
+ Toda a memória do Pool é devolvida de uma só vez ao destruí-lo, sem
+ precisar liberar objeto por objeto.
+
+ O TAD é implementado utilizando ponteiros opacos (void *), ocultando
+ a representação interna da estrutura.
+*/
+
+typedef void *Pool;
+
+
+/* ========== MODELO DOS COMENTARIOS ==========
+                    * Explicação do que a função representa
+                    *
+                    * Significado dos parametros
+                    *
+                    * Pré condição
+                    * Pós condição 
+*/
+
+
+/*
+Cria um novo Pool vazio para objetos de um tamanho fixo.
+
+ tamanhoObjeto: tamanho em bytes de cada objeto entregue pelo Pool
+ objetosPorBloco: quantos objetos cabem em cada bloco pedido ao sistema
+
+ tamanhoObjeto e objetosPorBloco devem ser maiores que zero
+ Retorna um ponteiro opaco para o Pool criado.
+*/
+Pool criaPool(size_t tamanhoObjeto, int objetosPorBloco);
+
+/*
+Entrega um objeto do Pool. Reaproveita um objeto liberado, se houver;
+senão avança no bloco atual, pedindo um novo bloco quando este acabar.
+
+ p: ponteiro para o Pool
+
+ O Pool deve estar inicializado
+ Retorna um ponteiro para a memória do objeto (conteúdo não inicializado).
+*/
+void *alocaObjetoPool(Pool p);
+
+/*
+Devolve um objeto ao Pool para ser reaproveitado.
+
+ p: ponteiro para o Pool
+ obj: objeto entregue anteriormente por alocaObjetoPool neste mesmo Pool
+
+ 'obj' não deve ser usado depois desta chamada
+ O objeto passa para a lista de livres do Pool.
+*/
+void liberaObjetoPool(Pool p, void *obj);
+
+/*
+Retorna quantos objetos do Pool estão em uso no momento.
+
+ p: ponteiro para o Pool
+
+ O Pool deve estar inicializado
+ Retorna o número de objetos alocados e ainda não liberados.
+*/
+int getObjetosEmUsoPool(const Pool p);
+
+/*
+Libera de uma só vez todos os blocos do Pool e a própria estrutura.
+
+ p: ponteiro para o Pool a ser destruído
+
+ Nenhum objeto do Pool deve ser usado depois desta chamada
+ Toda a memória do Pool é liberada, inclusive a dos objetos em uso.
+*/
+void destroiPool(Pool p);
+
+
+#endif
@@ -0,0 +1,161 @@
+#include "tabelaHash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// posições do índice ao criar a tabela; a sondagem usa 'capacidade - 1'
+// como máscara, então a capacidade começa e continua potência de 2
+#define CAPACIDADE_INICIAL_INDICE 16
+
+// marca, no índice, uma posição que não aponta para nenhum par
+#define SEM_PAR -1
+
+typedef struct {
+    int chave;
+    void *valor;
+} ParHash;
+
+typedef struct {
+    ParHash *pares;   // pares na ordem de inserção
+    int numPares;
+    int capacidadePares;
+
+    int *indice;      // posições de 'pares' (ou SEM_PAR)
+    int capacidadeIndice;
+} TabelaHashC;
+
+// espalhamento multiplicativo (Fibonacci) com os bits altos dobrados sobre
+// os baixos: ids seguidos caem longe entre si
+static unsigned int espalhaChave(int chave) {
+    unsigned int h = (unsigned int) chave * 2654435769u;
+    return h ^ (h >> 15);
+}
+
+/*
+Sonda o índice a partir do espalhamento de 'chave', uma posição por vez,
+comparando a chave do par apontado. Para no par com essa chave ou na
+primeira SEM_PAR; nesse caso é ali que um novo par seria registrado.
+*/
+static int buscaIndice(const TabelaHashC *t, int chave) {
+    int mascara = t->capacidadeIndice - 1;
+    int pos = (int) (espalhaChave(chave) & (unsigned int) mascara);
+    while (t->indice[pos] != SEM_PAR && t->pares[t->indice[pos]].chave != chave) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+/*
+Troca o índice por outro com o dobro de posições. Com a nova máscara as
+posições antigas não valem mais, então cada par do vetor é registrado de
+novo; o vetor de pares em si não muda (a ordem de inserção se mantém).
+*/
+static void cresceIndice(TabelaHashC *t) {
+    int novaCapacidade = t->capacidadeIndice * 2;
+    int *novo = (int*) malloc(novaCapacidade * sizeof(int));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int i = 0; i < novaCapacidade; i++) {
+        novo[i] = SEM_PAR;
+    }
+
+    free(t->indice);
+    t->indice = novo;
+    t->capacidadeIndice = novaCapacidade;
+
+    for (int i = 0; i < t->numPares; i++) {
+        t->indice[buscaIndice(t, t->pares[i].chave)] = i;
+    }
+}
+
+TabelaHash criaTabelaHash() {
+    TabelaHashC *t = (TabelaHashC*) malloc(sizeof(TabelaHashC));
+    int *indice = (int*) malloc(CAPACIDADE_INICIAL_INDICE * sizeof(int));
+    if (t == NULL || indice == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int i = 0; i < CAPACIDADE_INICIAL_INDICE; i++) {
+        indice[i] = SEM_PAR;
+    }
+
+    t->pares = NULL;
+    t->numPares = 0;
+    t->capacidadePares = 0;
+    t->indice = indice;
+    t->capacidadeIndice = CAPACIDADE_INICIAL_INDICE;
+    return (TabelaHash) t;
+}
+
+void *buscaTabelaHash(const TabelaHash t, int chave) {
+    TabelaHashC *tab = (TabelaHashC*) t;
+    if (tab == NULL) {
+        return NULL;
+    }
+    int pos = buscaIndice(tab, chave);
+    if (tab->indice[pos] == SEM_PAR) {
+        return NULL;
+    }
+    return tab->pares[tab->indice[pos]].valor;
+}
+
+void insereTabelaHash(TabelaHash t, int chave, void *valor) {
+    TabelaHashC *tab = (TabelaHashC*) t;
+
+    int pos = buscaIndice(tab, chave);
+    if (tab->indice[pos] != SEM_PAR) {
+        tab->pares[tab->indice[pos]].valor = valor;
+        return;
+    }
+
+    if (tab->numPares == tab->capacidadePares) {
+        int novaCapacidade = (tab->capacidadePares == 0) ? 16 : tab->capacidadePares * 2;
+        ParHash *novo = (ParHash*) realloc(tab->pares, novaCapacidade * sizeof(ParHash));
+        if (novo == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+        tab->pares = novo;
+        tab->capacidadePares = novaCapacidade;
+    }
+
+    tab->pares[tab->numPares].chave = chave;
+    tab->pares[tab->numPares].valor = valor;
+    tab->indice[pos] = tab->numPares;
+    tab->numPares++;
+
+    // com mais pares que metade das posições as sondagens ficam longas
+    if (2 * tab->numPares > tab->capacidadeIndice) {
+        cresceIndice(tab);
+    }
+}
+
+int getTamanhoTabelaHash(const TabelaHash t) {
+    TabelaHashC *tab = (TabelaHashC*) t;
+    if (tab == NULL) {
+        return 0;
+    }
+    return tab->numPares;
+}
+
+void iteraTabelaHash(const TabelaHash t, void (*executa)(int chave, void *valor, void *auxData), void *auxData) {
+    TabelaHashC *tab = (TabelaHashC*) t;
+    if (tab == NULL || executa == NULL) {
+        return;
+    }
+    for (int i = 0; i < tab->numPares; i++) {
+        executa(tab->pares[i].chave, tab->pares[i].valor, auxData);
+    }
+}
+
+void destroiTabelaHash(TabelaHash t) {
+    TabelaHashC *tab = (TabelaHashC*) t;
+    if (tab == NULL) {
+        return;
+    }
+    free(tab->pares);
+    free(tab->indice);
+    free(tab);
+}
@@ -0,0 +1,59 @@
+#ifndef TABELAHASH_H
+#define TABELAHASH_H
+
+#include <stdbool.h>
+
+/*
+ TIPO ABSTRATO DE DADOS: TABELA HASH (CHAVE INTEIRA)
+
+ Associa chaves inteiras (ids) a ponteiros genéricos, sem limite de
+ quantidade. Os pares ficam em um vetor na ordem de inserção e um índice
+ de espalhamento com endereçamento aberto (sondagem linear, mantido no
+ máximo meio cheio) aponta para posições desse vetor. Busca e inserção
+ custam O(1) em média; percorrer a tabela segue a ordem de inserção.
+*/
+
+typedef void *TabelaHash;
+
+
+/*
+Cria uma tabela vazia.
+Retorna um ponteiro opaco para a tabela, ou encerra o programa se não
+houver memória.
+*/
+TabelaHash criaTabelaHash();
+
+/* ========== MODELO DOS COMENTARIOS ==========
+                    * Explicação do que a função representa
+ Parâmetros:        * t: ponteiro para a tabela
+ Pré-condição:      * t deve ser uma tabela válida
+ Pós-condição:      * o que muda/retorna
+*/
+
+/*
+Retorna o valor associado a 'chave', ou NULL se a chave não estiver na tabela.
+*/
+void *buscaTabelaHash(const TabelaHash t, int chave);
+
+/*
+Associa 'valor' a 'chave'. Se a chave já existir, o valor é substituído.
+Pós-condição: a tabela cresce se preciso (o programa é encerrado se não
+houver memória).
+*/
+void insereTabelaHash(TabelaHash t, int chave, void *valor);
+
+// Retorna quantos pares a tabela contém
+int getTamanhoTabelaHash(const TabelaHash t);
+
+/*
+Percorre os pares na ordem de inserção, chamando 'executa' para cada um.
+*/
+void iteraTabelaHash(const TabelaHash t, void (*executa)(int chave, void *valor, void *auxData), void *auxData);
+
+/*
+Libera a tabela. Os valores não são liberados (use iteraTabelaHash antes,
+se eles pertencerem à tabela).
+*/
+void destroiTabelaHash(TabelaHash t);
+
+#endif
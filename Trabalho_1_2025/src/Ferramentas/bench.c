@@ -0,0 +1,799 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "fila.h"
+#include "pilha.h"
+#include "formas.h"
+#include "sobreposicao.h"
+#include "sobreposicaoLote.h"
+#include "escritorSvg.h"
+#include "contadorAlocacoes.h"
+
+/*_______________________ BENCHMARKS DOS MÓDULOS _______________________*/
+/*
+* Programa independente (não faz parte do executável 'ted') que mede o
+* custo por operação das estruturas do projeto. É gerado com 'make bench'.
+*
+* - Saída: um objeto JSON em stdout com um registro por medição (nome,
+* operações, ns/op e alocações/op); avisos vão para stderr.
+*
+* - Contagem de alocações: o makefile liga este binário com
+* -Wl,--wrap=malloc (e calloc/realloc), então toda chamada feita pelos
+* módulos passa pelo contador de contadorAlocacoes.h.
+*/
+
+
+/*________________________________ MEDIÇÃO ________________________________*/
+
+static double agoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+typedef struct {
+    double inicioNs;
+    long alocacoesInicio;
+} Medicao;
+
+static Medicao iniciaMedicao() {
+    Medicao m;
+    m.alocacoesInicio = getNumAlocacoes();
+    m.inicioNs = agoraNs();
+    return m;
+}
+
+static bool primeiroRegistro = true;
+
+// string JSON entre aspas (os nomes só têm ASCII imprimível)
+static void escreveStrJson(const char *s) {
+    putchar('"');
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            putchar('\\');
+        }
+        putchar(*s);
+    }
+    putchar('"');
+}
+
+static void escreveRegistro(const char *nome, long ops, double totalNs, long alocacoes,
+                            bool temVerificacao, long verificacao) {
+    printf("%s\n    {\"nome\": ", primeiroRegistro ? "" : ",");
+    escreveStrJson(nome);
+    printf(", \"ops\": %ld, \"ns_por_op\": %.3f, \"aloc_por_op\": %.4f",
+           ops, totalNs / ops, (double) alocacoes / ops);
+    if (temVerificacao) {
+        printf(", \"verificacao\": %ld", verificacao);
+    }
+    putchar('}');
+    fflush(stdout);
+    primeiroRegistro = false;
+}
+
+static void registraMedicao(Medicao m, const char *nome, long ops, bool temVerificacao, long verificacao) {
+    double totalNs = agoraNs() - m.inicioNs;
+    long alocacoes = getNumAlocacoes() - m.alocacoesInicio;
+    escreveRegistro(nome, ops, totalNs, alocacoes, temVerificacao, verificacao);
+}
+
+static void encerraMedicao(Medicao m, const char *nome, long ops) {
+    registraMedicao(m, nome, ops, false, 0);
+}
+
+// 'verificacao' (ex: pares sobrepostos) confere que versões diferentes
+// concordam e impede o compilador de descartar as chamadas medidas
+static void encerraMedicaoVerificada(Medicao m, const char *nome, long ops, long verificacao) {
+    registraMedicao(m, nome, ops, true, verificacao);
+}
+
+
+/*________________________________ FILA ________________________________*/
+
+// fila encadeada com um nó por elemento (implementação anterior de
+// fila.c), mantida aqui só como referência de comparação
+typedef struct noFilaRef {
+    Item item;
+    struct noFilaRef *prox;
+} NoFilaRef;
+
+typedef struct {
+    NoFilaRef *primeiro;
+    NoFilaRef *ultimo;
+} FilaRef;
+
+static void enfileiraRef(FilaRef *f, Item i) {
+    NoFilaRef *novo = (NoFilaRef*) malloc(sizeof(NoFilaRef));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    novo->item = i;
+    novo->prox = NULL;
+    if (f->ultimo == NULL) {
+        f->primeiro = novo;
+    } else {
+        f->ultimo->prox = novo;
+    }
+    f->ultimo = novo;
+}
+
+static Item desenfileiraRef(FilaRef *f) {
+    NoFilaRef *temp = f->primeiro;
+    Item info = temp->item;
+    f->primeiro = temp->prox;
+    if (f->primeiro == NULL) {
+        f->ultimo = NULL;
+    }
+    free(temp);
+    return info;
+}
+
+static void benchFila(long n) {
+    int valor = 0;
+
+    // carga: enche a fila com n itens e esvazia em seguida
+    FilaRef ref = { NULL, NULL };
+    Medicao m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        enfileiraRef(&ref, &valor);
+    }
+    while (ref.primeiro != NULL) {
+        desenfileiraRef(&ref);
+    }
+    encerraMedicao(m, "fila encadeada (ref): enche e esvazia", 2 * n);
+
+    m = iniciaMedicao();
+    Queue q = createQueue();
+    for (long i = 0; i < n; i++) {
+        enfileira(q, &valor);
+    }
+    while (!estaVaziaFila(q)) {
+        desenfileira(q);
+    }
+    destroiFila(q);
+    encerraMedicao(m, "fila: enche e esvazia", 2 * n);
+
+    // regime: tamanho estável, um desenfileira e um enfileira por passo
+    // (é o padrão das rotações do Chão e da Arena)
+    for (long i = 0; i < 1000; i++) {
+        enfileiraRef(&ref, &valor);
+    }
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        enfileiraRef(&ref, desenfileiraRef(&ref));
+    }
+    encerraMedicao(m, "fila encadeada (ref): rotacao (regime)", 2 * n);
+    while (ref.primeiro != NULL) {
+        desenfileiraRef(&ref);
+    }
+
+    q = createQueue();
+    for (long i = 0; i < 1000; i++) {
+        enfileira(q, &valor);
+    }
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        enfileira(q, desenfileira(q));
+    }
+    encerraMedicao(m, "fila: rotacao (regime)", 2 * n);
+    destroiFila(q);
+}
+
+
+/*________________________________ PILHA ________________________________*/
+
+// pilha encadeada com um nó por elemento (implementação anterior de
+// pilha.c), mantida aqui só como referência de comparação
+typedef struct noRef {
+    Item item;
+    struct noRef *prox;
+} NoRef;
+
+static void empilhaRef(NoRef **topo, Item i) {
+    NoRef *novo = (NoRef*) malloc(sizeof(NoRef));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    novo->item = i;
+    novo->prox = *topo;
+    *topo = novo;
+}
+
+static Item desempilhaRef(NoRef **topo) {
+    NoRef *temp = *topo;
+    Item info = temp->item;
+    *topo = temp->prox;
+    free(temp);
+    return info;
+}
+
+static void benchPilha(long n) {
+    int valor = 0;
+
+    // regime do preparaDisparo: a pilha mantém o tamanho e cada passo
+    // é um empilha seguido de um desempilha
+    NoRef *topoRef = NULL;
+    for (long i = 0; i < 1000; i++) {
+        empilhaRef(&topoRef, &valor);
+    }
+    Medicao m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        empilhaRef(&topoRef, &valor);
+        desempilhaRef(&topoRef);
+    }
+    encerraMedicao(m, "pilha encadeada (ref): push/pop", 2 * n);
+    while (topoRef != NULL) {
+        desempilhaRef(&topoRef);
+    }
+
+    Stack p = createStk();
+    for (long i = 0; i < 1000; i++) {
+        empilha(p, &valor);
+    }
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        empilha(p, &valor);
+        desempilha(p);
+    }
+    encerraMedicao(m, "pilha: push/pop", 2 * n);
+    destroiPilha(p);
+
+    // carga: n empilhamentos seguidos de n desempilhamentos
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        empilhaRef(&topoRef, &valor);
+    }
+    while (topoRef != NULL) {
+        desempilhaRef(&topoRef);
+    }
+    encerraMedicao(m, "pilha encadeada (ref): enche e esvazia", 2 * n);
+
+    m = iniciaMedicao();
+    p = createStk();
+    for (long i = 0; i < n; i++) {
+        empilha(p, &valor);
+    }
+    while (!estaVaziaPilha(p)) {
+        desempilha(p);
+    }
+    destroiPilha(p);
+    encerraMedicao(m, "pilha: enche e esvazia", 2 * n);
+}
+
+
+/*________________________________ SOBREPOSIÇÃO ________________________________*/
+
+// cadeia de if/else por par de tipos (implementação anterior do laço da
+// arena), mantida aqui só como referência de comparação
+static bool sobrepoeRef(Forma fI, Forma fJ) {
+    TipoForma tI = getFormaTipo(fI);
+    TipoForma tJ = getFormaTipo(fJ);
+
+    if (tI == TIPO_CIRCULO && tJ == TIPO_CIRCULO) {
+        return sobreposicaoCirculoCirculo(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_CIRCULO && tJ == TIPO_RETANGULO) {
+        return sobreposicaoCirculoRetangulo(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_RETANGULO && tJ == TIPO_CIRCULO) {
+        return sobreposicaoCirculoRetangulo(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_RETANGULO && tJ == TIPO_RETANGULO) {
+        return sobreposicaoRetanguloRetangulo(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_CIRCULO && tJ == TIPO_LINHA) {
+        return sobreposicaoCirculoLinha(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_LINHA && tJ == TIPO_CIRCULO) {
+        return sobreposicaoCirculoLinha(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_CIRCULO && tJ == TIPO_TEXTO) {
+        return sobreposicaoCirculoTexto(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_TEXTO && tJ == TIPO_CIRCULO) {
+        return sobreposicaoCirculoTexto(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_RETANGULO && tJ == TIPO_LINHA) {
+        return sobreposicaoRetanguloLinha(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_LINHA && tJ == TIPO_RETANGULO) {
+        return sobreposicaoRetanguloLinha(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_RETANGULO && tJ == TIPO_TEXTO) {
+        return sobreposicaoRetanguloTexto(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_TEXTO && tJ == TIPO_RETANGULO) {
+        return sobreposicaoRetanguloTexto(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_LINHA && tJ == TIPO_LINHA) {
+        return sobreposicaoLinhaLinha(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_LINHA && tJ == TIPO_TEXTO) {
+        return sobreposicaoLinhaTexto(getFormaAssoc(fI), getFormaAssoc(fJ));
+    } else if (tI == TIPO_TEXTO && tJ == TIPO_LINHA) {
+        return sobreposicaoLinhaTexto(getFormaAssoc(fJ), getFormaAssoc(fI));
+    } else if (tI == TIPO_TEXTO && tJ == TIPO_TEXTO) {
+        return sobreposicaoTextoTexto(getFormaAssoc(fI), getFormaAssoc(fJ));
+    }
+    return false;
+}
+
+// gerador congruencial simples: mesma sequência em toda execução
+static unsigned long sementeBench = 12345;
+
+static unsigned long aleatorioBench() {
+    sementeBench = sementeBench * 6364136223846793005UL + 1442695040888963407UL;
+    return sementeBench >> 33;
+}
+
+static double coordenadaBench(double max) {
+    return (double)(aleatorioBench() % 10000) / 10000.0 * max;
+}
+
+// cria uma forma do tipo indicado em (x, y), com medidas aleatórias
+static Forma formaDoTipoBench(int id, TipoForma tipo, double x, double y, Estilo estilo) {
+    switch (tipo) {
+        case TIPO_CIRCULO:
+            return criaForma(id, TIPO_CIRCULO,
+                             criarCirculo(id, x, y, 1.0 + coordenadaBench(20.0), "red", "blue", false, 0));
+        case TIPO_RETANGULO:
+            return criaForma(id, TIPO_RETANGULO,
+                             criarRetangulo(id, x, y, 1.0 + coordenadaBench(30.0), 1.0 + coordenadaBench(30.0),
+                                            "red", "blue", false, 0));
+        case TIPO_LINHA:
+            return criaForma(id, TIPO_LINHA,
+                             criarLinha(id, x, y, coordenadaBench(200.0), coordenadaBench(200.0), "red", false, 0));
+        default:
+            return criaForma(id, TIPO_TEXTO,
+                             criarTexto(id, x, y, "red", "blue", "imf"[aleatorioBench() % 3], "texto", estilo));
+    }
+}
+
+// cria uma forma de tipo aleatório em uma área 200x200
+static Forma formaAleatoriaBench(int id, Estilo estilo) {
+    double x = coordenadaBench(200.0);
+    double y = coordenadaBench(200.0);
+    return formaDoTipoBench(id, (TipoForma) (aleatorioBench() % 4), x, y, estilo);
+}
+
+#define NUM_FORMAS_BENCH 1024
+#define NUM_PARES_BENCH 4096
+
+// rodadas alternadas entre a cadeia e a tabela
+#define RODADAS_SOBREPOSICAO 10
+
+typedef bool (*SobrepoeBench)(Forma, Forma);
+
+// 'n' pares da sequência fixa; retorna quantos se sobrepõem
+static long passadaSobreposicao(SobrepoeBench sobrepoeFn, Forma *formas, const int *paresI,
+                                const int *paresJ, long n) {
+    long acertos = 0;
+    for (long i = 0; i < n; i++) {
+        int k = i & (NUM_PARES_BENCH - 1);
+        acertos += sobrepoeFn(formas[paresI[k]], formas[paresJ[k]]);
+    }
+    return acertos;
+}
+
+static void benchSobreposicao(long n) {
+    Estilo estilo = criarEstilo("sans-serif", "normal", "12");
+    Forma formas[NUM_FORMAS_BENCH];
+    for (int i = 0; i < NUM_FORMAS_BENCH; i++) {
+        formas[i] = formaAleatoriaBench(i, estilo);
+    }
+
+    // pares com mistura aleatória de tipos, para o preditor de desvios
+    // não conseguir aprender a sequência da cadeia de if/else
+    int paresI[NUM_PARES_BENCH], paresJ[NUM_PARES_BENCH];
+    for (int k = 0; k < NUM_PARES_BENCH; k++) {
+        paresI[k] = aleatorioBench() % NUM_FORMAS_BENCH;
+        paresJ[k] = aleatorioBench() % NUM_FORMAS_BENCH;
+    }
+
+    // uma passada sem medir aquece cache e relógio da CPU; depois as duas
+    // versões se alternam em rodadas, cada uma começando metade delas, para
+    // a ordem não favorecer nenhuma. 'acertos' confere que concordam e
+    // mantém as chamadas no programa
+    SobrepoeBench versoes[2] = { sobrepoeRef, sobrepoe };
+    const char *nomes[2] = { "sobreposicao: cadeia if/else (ref)", "sobreposicao: tabela de despacho" };
+    for (int v = 0; v < 2; v++) {
+        passadaSobreposicao(versoes[v], formas, paresI, paresJ, NUM_PARES_BENCH);
+    }
+
+    long porRodada = n / RODADAS_SOBREPOSICAO;
+    long acertos[2] = { 0, 0 };
+    long alocacoes[2] = { 0, 0 };
+    double totalNs[2] = { 0.0, 0.0 };
+    for (int r = 0; r < RODADAS_SOBREPOSICAO; r++) {
+        for (int k = 0; k < 2; k++) {
+            int v = (r + k) % 2;
+            Medicao m = iniciaMedicao();
+            acertos[v] += passadaSobreposicao(versoes[v], formas, paresI, paresJ, porRodada);
+            totalNs[v] += agoraNs() - m.inicioNs;
+            alocacoes[v] += getNumAlocacoes() - m.alocacoesInicio;
+        }
+    }
+    for (int v = 0; v < 2; v++) {
+        escreveRegistro(nomes[v], porRodada * RODADAS_SOBREPOSICAO, totalNs[v], alocacoes[v], true, acertos[v]);
+    }
+
+    for (int i = 0; i < NUM_FORMAS_BENCH; i++) {
+        destroiForma(formas[i]);
+    }
+    destroiEstilo(estilo);
+}
+
+
+/*________________________________ ESPECIALISTAS DE SOBREPOSIÇÃO ________________________________*/
+
+// cada função sobreposicao* de sobreposicao.h, com os tipos que ela recebe
+static const struct {
+    const char *nome;
+    TipoForma tipoA, tipoB;
+    bool (*funcao)(void*, void*);
+} ESPECIALISTAS_BENCH[] = {
+    { "sobreposicaoCirculoCirculo",       TIPO_CIRCULO,   TIPO_CIRCULO,   sobreposicaoCirculoCirculo },
+    { "sobreposicaoCirculoRetangulo",     TIPO_CIRCULO,   TIPO_RETANGULO, sobreposicaoCirculoRetangulo },
+    { "sobreposicaoCirculoLinha",         TIPO_CIRCULO,   TIPO_LINHA,     sobreposicaoCirculoLinha },
+    { "sobreposicaoCirculoTexto",         TIPO_CIRCULO,   TIPO_TEXTO,     sobreposicaoCirculoTexto },
+    { "sobreposicaoRetanguloRetangulo",   TIPO_RETANGULO, TIPO_RETANGULO, sobreposicaoRetanguloRetangulo },
+    { "sobreposicaoRetanguloLinha",       TIPO_RETANGULO, TIPO_LINHA,     sobreposicaoRetanguloLinha },
+    { "sobreposicaoRetanguloTexto",       TIPO_RETANGULO, TIPO_TEXTO,     sobreposicaoRetanguloTexto },
+    { "sobreposicaoLinhaLinha",           TIPO_LINHA,     TIPO_LINHA,     sobreposicaoLinhaLinha },
+    { "sobreposicaoLinhaTexto",           TIPO_LINHA,     TIPO_TEXTO,     sobreposicaoLinhaTexto },
+    { "sobreposicaoTextoTexto",           TIPO_TEXTO,     TIPO_TEXTO,     sobreposicaoTextoTexto }
+};
+#define NUM_ESPECIALISTAS_BENCH ((int) (sizeof(ESPECIALISTAS_BENCH) / sizeof(ESPECIALISTAS_BENCH[0])))
+
+static void benchEspecialistas(long n) {
+    Estilo estilo = criarEstilo("sans-serif", "normal", "12");
+    Forma formasA[NUM_PARES_BENCH], formasB[NUM_PARES_BENCH];
+    void *dadosA[NUM_PARES_BENCH], *dadosB[NUM_PARES_BENCH];
+    char nome[96];
+
+    for (int e = 0; e < NUM_ESPECIALISTAS_BENCH; e++) {
+        // pares aleatórios dos dois tipos na mesma área 200x200
+        for (int k = 0; k < NUM_PARES_BENCH; k++) {
+            double x = coordenadaBench(200.0);
+            double y = coordenadaBench(200.0);
+            formasA[k] = formaDoTipoBench(k, ESPECIALISTAS_BENCH[e].tipoA, x, y, estilo);
+            x = coordenadaBench(200.0);
+            y = coordenadaBench(200.0);
+            formasB[k] = formaDoTipoBench(k, ESPECIALISTAS_BENCH[e].tipoB, x, y, estilo);
+            dadosA[k] = getFormaAssoc(formasA[k]);
+            dadosB[k] = getFormaAssoc(formasB[k]);
+        }
+
+        bool (*funcao)(void*, void*) = ESPECIALISTAS_BENCH[e].funcao;
+        long acertos = 0;
+        Medicao m = iniciaMedicao();
+        for (long i = 0; i < n; i++) {
+            int k = i & (NUM_PARES_BENCH - 1);
+            acertos += funcao(dadosA[k], dadosB[k]);
+        }
+        snprintf(nome, sizeof(nome), "sobreposicao: %s", ESPECIALISTAS_BENCH[e].nome);
+        encerraMedicaoVerificada(m, nome, n, acertos);
+
+        for (int k = 0; k < NUM_PARES_BENCH; k++) {
+            destroiForma(formasA[k]);
+            destroiForma(formasB[k]);
+        }
+    }
+    destroiEstilo(estilo);
+}
+
+
+/*________________________________ CICLO DE VIDA DAS FORMAS ________________________________*/
+
+#define NUM_FORMAS_VIVAS 4096
+
+// texto como era antes do pool, das cores internadas e do estilo
+// compartilhado: invólucro, texto, cada cor, o conteúdo e uma cópia do
+// estilo em blocos separados (9 alocações); mantido só como referência
+typedef struct {
+    char *familia, *peso, *tamanho;
+} EstiloRef;
+
+typedef struct {
+    int id;
+    double x, y;
+    char *corb, *corp;
+    char ancora;
+    char *conteudo;
+    EstiloRef *estilo;
+} TextoRef;
+
+typedef struct {
+    int id;
+    TipoForma tipo;
+    void *dados;
+} FormaRef;
+
+static void *alocaRef(size_t tam) {
+    void *p = malloc(tam);
+    if (p == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    return p;
+}
+
+static char *copiaStringRef(const char *s) {
+    size_t tam = strlen(s) + 1;
+    return (char*) memcpy(alocaRef(tam), s, tam);
+}
+
+static FormaRef *criaTextoRef(int id, double x, double y, const char *corb, const char *corp,
+                              char ancora, const char *conteudo, const EstiloRef *estilo) {
+    TextoRef *t = (TextoRef*) alocaRef(sizeof(TextoRef));
+    t->id = id;
+    t->x = x;
+    t->y = y;
+    t->corb = copiaStringRef(corb);
+    t->corp = copiaStringRef(corp);
+    t->ancora = ancora;
+    t->conteudo = copiaStringRef(conteudo);
+    t->estilo = (EstiloRef*) alocaRef(sizeof(EstiloRef));
+    t->estilo->familia = copiaStringRef(estilo->familia);
+    t->estilo->peso = copiaStringRef(estilo->peso);
+    t->estilo->tamanho = copiaStringRef(estilo->tamanho);
+
+    FormaRef *f = (FormaRef*) alocaRef(sizeof(FormaRef));
+    f->id = id;
+    f->tipo = TIPO_TEXTO;
+    f->dados = t;
+    return f;
+}
+
+static void destroiTextoRef(FormaRef *f) {
+    TextoRef *t = (TextoRef*) f->dados;
+    free(t->estilo->familia);
+    free(t->estilo->peso);
+    free(t->estilo->tamanho);
+    free(t->estilo);
+    free(t->corb);
+    free(t->corp);
+    free(t->conteudo);
+    free(t);
+    free(f);
+}
+
+static void benchCicloFormas(long n) {
+    static const char *nomesTipos[] = { "circulo", "retangulo", "linha", "texto" };
+    Estilo estilo = criarEstilo("sans-serif", "normal", "12");
+    char nome[96];
+
+    // criaForma seguido de destroiForma, um tipo por vez
+    for (int t = 0; t < 4; t++) {
+        Medicao m = iniciaMedicao();
+        for (long i = 0; i < n; i++) {
+            destroiForma(formaDoTipoBench((int) i, (TipoForma) t, 10.0, 20.0, estilo));
+        }
+        snprintf(nome, sizeof(nome), "formas: cria/destroi %s", nomesTipos[t]);
+        encerraMedicao(m, nome, n);
+    }
+
+    // o mesmo texto no esquema antigo, com a cópia do estilo por texto
+    EstiloRef estiloRef = { "sans-serif", "normal", "12" };
+    Medicao m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        destroiTextoRef(criaTextoRef((int) i, 10.0, 20.0, "red", "blue", "imf"[i % 3], "texto", &estiloRef));
+    }
+    encerraMedicao(m, "formas: cria/destroi texto (ref)", n);
+
+    // regime: conjunto vivo de formas em que uma forma aleatória é
+    // destruída e substituída por outra de tipo aleatório a cada passo
+    Forma vivas[NUM_FORMAS_VIVAS];
+    for (int k = 0; k < NUM_FORMAS_VIVAS; k++) {
+        vivas[k] = formaAleatoriaBench(k, estilo);
+    }
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        int k = (int) (aleatorioBench() % NUM_FORMAS_VIVAS);
+        destroiForma(vivas[k]);
+        vivas[k] = formaAleatoriaBench((int) i, estilo);
+    }
+    encerraMedicao(m, "formas: troca no conjunto vivo (mistura)", n);
+
+    for (int k = 0; k < NUM_FORMAS_VIVAS; k++) {
+        destroiForma(vivas[k]);
+    }
+    destroiEstilo(estilo);
+}
+
+
+/*________________________________ SOBREPOSIÇÃO EM LOTE (SIMD) ________________________________*/
+
+#define NUM_PARES_LOTE 4096
+
+static const char *nomeNivelSimd(NivelSimd nivel) {
+    switch (nivel) {
+        case SIMD_AVX2: return "avx2";
+        case SIMD_SSE2: return "sse2";
+        default: return "escalar";
+    }
+}
+
+// mede n pares do núcleo círculo-retângulo e da avaliação completa de pares
+// (agrupamento por tipo + núcleos) no nível indicado
+static void benchLoteNivel(long n, NivelSimd nivel, double *coords[7], const Forma *formas,
+                           bool *resultado, long *acertosNucleo, long *acertosPares) {
+    char nome[64];
+    defineNivelSimd(nivel);
+
+    *acertosNucleo = 0;
+    Medicao m = iniciaMedicao();
+    long feitos = 0;
+    while (feitos < n) {
+        sobrepoeLoteCirculoRetangulo(NUM_PARES_LOTE, coords[0], coords[1], coords[2],
+                                     coords[3], coords[4], coords[5], coords[6], resultado);
+        feitos += NUM_PARES_LOTE;
+    }
+    for (int k = 0; k < NUM_PARES_LOTE; k++) *acertosNucleo += resultado[k];
+    snprintf(nome, sizeof(nome), "lote: nucleo circ-ret (%s)", nomeNivelSimd(nivel));
+    encerraMedicaoVerificada(m, nome, feitos, *acertosNucleo);
+
+    *acertosPares = 0;
+    m = iniciaMedicao();
+    feitos = 0;
+    while (feitos < n) {
+        sobrepoePares(formas, NUM_PARES_LOTE, resultado);
+        feitos += NUM_PARES_LOTE;
+    }
+    for (int k = 0; k < NUM_PARES_LOTE; k++) *acertosPares += resultado[k];
+    snprintf(nome, sizeof(nome), "lote: sobrepoePares (%s)", nomeNivelSimd(nivel));
+    encerraMedicaoVerificada(m, nome, feitos, *acertosPares);
+}
+
+static void benchSobreposicaoLote(long n) {
+    // coordenadas círculo-retângulo em vetores separados (estrutura de vetores)
+    double *coords[7];
+    for (int c = 0; c < 7; c++) {
+        coords[c] = (double*) malloc(NUM_PARES_LOTE * sizeof(double));
+        if (coords[c] == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+    }
+    for (int k = 0; k < NUM_PARES_LOTE; k++) {
+        coords[0][k] = coordenadaBench(200.0);
+        coords[1][k] = coordenadaBench(200.0);
+        coords[2][k] = 1.0 + coordenadaBench(20.0);
+        coords[3][k] = coordenadaBench(200.0);
+        coords[4][k] = coordenadaBench(200.0);
+        coords[5][k] = 1.0 + coordenadaBench(30.0);
+        coords[6][k] = 1.0 + coordenadaBench(30.0);
+    }
+
+    // pares formados só por círculos e retângulos, em ordem aleatória
+    Forma *formas = (Forma*) malloc(2 * NUM_PARES_LOTE * sizeof(Forma));
+    bool *resultado = (bool*) malloc(NUM_PARES_LOTE * sizeof(bool));
+    if (formas == NULL || resultado == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int i = 0; i < 2 * NUM_PARES_LOTE; i++) {
+        double x = coordenadaBench(200.0);
+        double y = coordenadaBench(200.0);
+        if (aleatorioBench() % 2 == 0) {
+            formas[i] = criaForma(i, TIPO_CIRCULO,
+                                  criarCirculo(i, x, y, 1.0 + coordenadaBench(20.0), "red", "blue", false, 0));
+        } else {
+            formas[i] = criaForma(i, TIPO_RETANGULO,
+                                  criarRetangulo(i, x, y, 1.0 + coordenadaBench(30.0), 1.0 + coordenadaBench(30.0),
+                                                 "red", "blue", false, 0));
+        }
+    }
+
+    // referência: sobrepoe() par a par
+    long acertosRef = 0;
+    Medicao m = iniciaMedicao();
+    long feitos = 0;
+    while (feitos < n) {
+        acertosRef = 0;
+        for (int p = 0; p < NUM_PARES_LOTE; p++) {
+            acertosRef += sobrepoe(formas[2 * p], formas[2 * p + 1]);
+        }
+        feitos += NUM_PARES_LOTE;
+    }
+    encerraMedicaoVerificada(m, "lote: sobrepoe par a par (ref)", feitos, acertosRef);
+
+    // todos os níveis suportados devem concordar com o escalar
+    NivelSimd suportado = nivelSimdSuportado();
+    long nucleoEscalar = -1;
+    for (int nivel = SIMD_ESCALAR; nivel <= (int) suportado; nivel++) {
+        long acertosNucleo, acertosPares;
+        benchLoteNivel(n, (NivelSimd) nivel, coords, formas, resultado, &acertosNucleo, &acertosPares);
+        if (nucleoEscalar < 0) nucleoEscalar = acertosNucleo;
+        if (acertosNucleo != nucleoEscalar || acertosPares != acertosRef) {
+            fprintf(stderr, "lote: DIVERGENCIA no nivel %s (%ld/%ld, %ld/%ld)\n", nomeNivelSimd((NivelSimd) nivel),
+                   acertosNucleo, nucleoEscalar, acertosPares, acertosRef);
+        }
+    }
+    defineNivelSimd(nivelSimdPadrao());
+
+    for (int i = 0; i < 2 * NUM_PARES_LOTE; i++) {
+        destroiForma(formas[i]);
+    }
+    free(formas);
+    free(resultado);
+    for (int c = 0; c < 7; c++) {
+        free(coords[c]);
+    }
+}
+
+
+/*________________________________ RENDERIZAÇÃO SVG ________________________________*/
+
+#define NUM_FORMAS_RENDER 1000000
+
+static void benchRenderizacao(long n) {
+    FILE *nulo = fopen("/dev/null", "w");
+    if (nulo == NULL) {
+        fprintf(stderr, "benchRenderizacao: /dev/null indisponivel\n");
+        return;
+    }
+
+    // formatação de um número com duas casas: printf x formatador próprio
+    double valores[1024];
+    for (int i = 0; i < 1024; i++) {
+        valores[i] = coordenadaBench(2000.0) - 500.0;
+    }
+    Medicao m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        fprintf(nulo, "%.2f", valores[i & 1023]);
+    }
+    encerraMedicao(m, "svg: fprintf(\"%.2f\") (ref)", n);
+
+    EscritorSvg svg = criaEscritorSvg(nulo);
+    m = iniciaMedicao();
+    for (long i = 0; i < n; i++) {
+        escreveDecimalSvg(svg, valores[i & 1023]);
+    }
+    descarregaEscritorSvg(svg);
+    encerraMedicao(m, "svg: escreveDecimalSvg", n);
+
+    // cena de 1M formas com mistura aleatória de tipos
+    Estilo estilo = criarEstilo("sans-serif", "normal", "12");
+    Forma *formas = (Forma*) malloc(NUM_FORMAS_RENDER * sizeof(Forma));
+    if (formas == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int i = 0; i < NUM_FORMAS_RENDER; i++) {
+        formas[i] = formaAleatoriaBench(i, estilo);
+    }
+
+    m = iniciaMedicao();
+    for (int i = 0; i < NUM_FORMAS_RENDER; i++) {
+        desenhaForma(formas[i], svg);
+    }
+    descarregaEscritorSvg(svg);
+    encerraMedicao(m, "svg: desenhaForma (1M formas)", NUM_FORMAS_RENDER);
+
+    destroiEscritorSvg(svg);
+    fclose(nulo);
+    for (int i = 0; i < NUM_FORMAS_RENDER; i++) {
+        destroiForma(formas[i]);
+    }
+    free(formas);
+    destroiEstilo(estilo);
+}
+
+
+int main(int argc, char *argv[]) {
+    long n = 10000000;
+    if (argc > 1) {
+        n = atol(argv[1]);
+    }
+    if (n <= 0) {
+        fprintf(stderr, "uso: %s [numero_de_operacoes]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("{\n  \"ops\": %ld,\n  \"resultados\": [", n);
+    benchFila(n);
+    benchPilha(n);
+    benchSobreposicao(n);
+    benchEspecialistas(n);
+    benchSobreposicaoLote(n);
+    benchCicloFormas(n);
+    benchRenderizacao(n);
+    printf("\n  ]\n}\n");
+
+    return EXIT_SUCCESS;
+}
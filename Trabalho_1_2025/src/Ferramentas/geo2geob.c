@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "chao.h"
+#include "cores.h"
+#include "texto.h"
+#include "memoriaFormas.h"
+#include "processaGeo.h"
+#include "processaGeob.h"
+
+/*_______________________ CONVERSOR .GEO -> .GEOB _______________________*/
+/*
+* Programa independente (não faz parte do executável 'ted') que lê um .geo
+* com o mesmo processaGeo do ted e grava as formas resultantes no formato
+* binário .geob (processaGeob.h). É gerado com 'make geob'.
+*
+* Como a conversão parte do Chão já montado, o .geob tem exatamente as
+* formas que o ted criaria: linhas mal formatadas e formas inválidas são
+* avisadas aqui e não entram no arquivo.
+*
+* uso: geo2geob <entrada.geo> <saida.geob>
+*/
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "uso: %s <entrada.geo> <saida.geob>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Chao chao = processaGeo(argv[1]);
+    if (chao == NULL) {
+        fprintf(stderr, "ERRO: Falha ao processar o arquivo GEO %s.\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    int numFormas = getChaoTamanho(chao);
+    bool gravou = escreveGeob(chao, argv[2]);
+
+    destroiChao(chao);
+    liberaTodaMemoriaFormas();
+    liberaTabelaEstilos();
+    liberaTabelaCores();
+
+    if (!gravou) {
+        fprintf(stderr, "ERRO: Nao foi possivel gravar o arquivo %s.\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    printf("%d formas gravadas em %s\n", numFormas, argv[2]);
+    return EXIT_SUCCESS;
+}
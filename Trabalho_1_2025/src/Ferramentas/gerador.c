@@ -0,0 +1,492 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/*_______________________ GERADOR DE CARGAS SINTÉTICAS _______________________*/
+/*
+* Programa independente (não faz parte do executável 'ted') que escreve um
+* par .geo/.qry para medir o ted em escala. É gerado com 'make gen'.
+*
+* O sorteio usa um gerador próprio (splitmix64) e os números são escritos
+* com casas decimais fixas, então a mesma semente (com as mesmas opções)
+* produz sempre os mesmos arquivos. Cada sorteio é feito em uma instrução
+* própria, porque a ordem de avaliação dos argumentos de uma chamada não é
+* definida em C.
+*
+* uso: gerador -o <prefixo> [opções]   (escreve <prefixo>.geo e <prefixo>.qry)
+*/
+
+#define PI 3.14159265358979323846
+
+// Largura e altura padrão: as da arena do ted
+#define LARGURA_PADRAO 1555.0
+#define ALTURA_PADRAO 810.0
+
+typedef enum { DIST_UNIFORME, DIST_AGLOMERADA, DIST_GRADE } Distribuicao;
+
+// comandos do .qry, na ordem dos pesos de -mixqry
+enum { CMD_PD, CMD_LC, CMD_ATCH, CMD_SHFT, CMD_DSP, CMD_RJD, CMD_CALC, NUM_COMANDOS };
+
+typedef struct {
+    const char *prefixo;
+    uint64_t semente;
+
+    // .geo
+    long numFormas;
+    double pesosFormas[4];      // c, r, l, t
+    double frequenciaTs;        // chance de um 'ts' antes de cada forma
+    int numCores;
+    Distribuicao distribuicao;
+    int numAglomerados;
+    double largura, altura;
+    double densidade;           // quantas formas cobrem, em média, um ponto
+
+    // .qry
+    int numDisparadores;
+    long numComandos;
+    double pesosComandos[NUM_COMANDOS];
+    long cargaMaxima;           // formas por 'lc'
+} Parametros;
+
+
+/*________________________________ SORTEIO ________________________________*/
+
+static uint64_t estado;
+
+static uint64_t proximo64() {
+    uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// real em [0, 1)
+static double sorteia() {
+    return (proximo64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double sorteiaEntre(double a, double b) {
+    return a + (b - a) * sorteia();
+}
+
+// inteiro em [a, b]
+static long sorteiaInteiro(long a, long b) {
+    return a + (long) (proximo64() % (uint64_t) (b - a + 1));
+}
+
+// normal padrão (Box-Muller)
+static double sorteiaNormal() {
+    double u = 1.0 - sorteia();
+    double v = sorteia();
+    return sqrt(-2.0 * log(u)) * cos(2.0 * PI * v);
+}
+
+// índice sorteado com probabilidade proporcional a pesos[i]
+static int sorteiaPeso(const double *pesos, int n) {
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        total += pesos[i];
+    }
+    double alvo = sorteia() * total;
+    for (int i = 0; i < n - 1; i++) {
+        if (alvo < pesos[i]) {
+            return i;
+        }
+        alvo -= pesos[i];
+    }
+    return n - 1;
+}
+
+
+/*________________________________ CORES E TEXTOS ________________________________*/
+
+static const char *CORES_NOMEADAS[] = {
+    "red", "blue", "green", "black", "yellow", "purple", "orange", "gray"
+};
+#define NUM_CORES_NOMEADAS ((int) (sizeof(CORES_NOMEADAS) / sizeof(CORES_NOMEADAS[0])))
+
+static const char *FAMILIAS[] = { "sans-serif", "serif", "cursive" };
+static const char *PESOS_FONTE[] = { "n", "b", "b+", "l" };
+static const char *TEXTOS[] = { "a", "xyz", "hello world", "texto com espacos", "ted" };
+
+// cor 'i' da paleta: primeiro as nomeadas, depois #rrggbb derivados de i
+static void escreveCor(FILE *f, int i) {
+    if (i < NUM_CORES_NOMEADAS) {
+        fputs(CORES_NOMEADAS[i], f);
+        return;
+    }
+    uint64_t h = (uint64_t) i * 0x9E3779B97F4A7C15ULL;
+    fprintf(f, "#%06x", (unsigned) ((h >> 40) & 0xFFFFFF));
+}
+
+static void escreveCorSorteada(FILE *f, const Parametros *p) {
+    escreveCor(f, (int) sorteiaInteiro(0, p->numCores - 1));
+}
+
+#define ESCOLHE(v) (v[sorteiaInteiro(0, (long) (sizeof(v) / sizeof(v[0])) - 1)])
+
+
+/*________________________________ .GEO ________________________________*/
+
+static double limita(double v, double maximo) {
+    if (v < 0.0) return 0.0;
+    if (v > maximo) return maximo;
+    return v;
+}
+
+// posição da forma 'i' conforme a distribuição escolhida
+static void sorteiaPosicao(const Parametros *p, long i, const double *centros,
+                           double *x, double *y) {
+    switch (p->distribuicao) {
+        case DIST_AGLOMERADA: {
+            long k = sorteiaInteiro(0, p->numAglomerados - 1);
+            double sigma = fmin(p->largura, p->altura) / 20.0;
+            *x = limita(centros[2 * k] + sigma * sorteiaNormal(), p->largura);
+            *y = limita(centros[2 * k + 1] + sigma * sorteiaNormal(), p->altura);
+            break;
+        }
+        case DIST_GRADE: {
+            long colunas = (long) ceil(sqrt(p->numFormas * p->largura / p->altura));
+            long linhas = (p->numFormas + colunas - 1) / colunas;
+            double dx = p->largura / colunas;
+            double dy = p->altura / linhas;
+            *x = ((i % colunas) + 0.5 + sorteiaEntre(-0.25, 0.25)) * dx;
+            *y = ((i / colunas) + 0.5 + sorteiaEntre(-0.25, 0.25)) * dy;
+            break;
+        }
+        default:
+            *x = sorteiaEntre(0.0, p->largura);
+            *y = sorteiaEntre(0.0, p->altura);
+            break;
+    }
+}
+
+static void geraGeo(FILE *f, const Parametros *p) {
+    // área média por forma escolhida para que, em média, 'densidade' formas
+    // cubram cada ponto; 'lado' é a raiz dessa área
+    double lado = sqrt(p->densidade * p->largura * p->altura / p->numFormas);
+
+    double *centros = (double*) malloc(2 * (size_t) p->numAglomerados * sizeof(double));
+    if (centros == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int k = 0; k < p->numAglomerados; k++) {
+        centros[2 * k] = sorteiaEntre(0.0, p->largura);
+        centros[2 * k + 1] = sorteiaEntre(0.0, p->altura);
+    }
+
+    for (long i = 0; i < p->numFormas; i++) {
+        long id = i + 1;
+        if (sorteia() < p->frequenciaTs) {
+            const char *familia = ESCOLHE(FAMILIAS);
+            const char *peso = ESCOLHE(PESOS_FONTE);
+            fprintf(f, "ts %s %s %ld\n", familia, peso, sorteiaInteiro(8, 30));
+        }
+
+        double x, y;
+        sorteiaPosicao(p, i, centros, &x, &y);
+
+        switch (sorteiaPeso(p->pesosFormas, 4)) {
+            case 0: // círculo com área média lado²
+                fprintf(f, "c %ld %.2f %.2f %.2f ", id, x, y,
+                        sorteiaEntre(0.5, 1.5) * lado / sqrt(PI));
+                escreveCorSorteada(f, p);
+                fputc(' ', f);
+                escreveCorSorteada(f, p);
+                break;
+            case 1: { // retângulo com área média lado²
+                double w = sorteiaEntre(0.5, 1.5) * lado;
+                double h = sorteiaEntre(0.5, 1.5) * lado;
+                fprintf(f, "r %ld %.2f %.2f %.2f %.2f ", id, x, y, w, h);
+                escreveCorSorteada(f, p);
+                fputc(' ', f);
+                escreveCorSorteada(f, p);
+                break;
+            }
+            case 2: { // linha com comprimento da ordem de 'lado'
+                double angulo = sorteiaEntre(0.0, 2.0 * PI);
+                double comprimento = sorteiaEntre(0.5, 1.5) * lado;
+                fprintf(f, "l %ld %.2f %.2f %.2f %.2f ", id, x, y,
+                        x + comprimento * cos(angulo), y + comprimento * sin(angulo));
+                escreveCorSorteada(f, p);
+                break;
+            }
+            default: {
+                fprintf(f, "t %ld %.2f %.2f ", id, x, y);
+                escreveCorSorteada(f, p);
+                fputc(' ', f);
+                escreveCorSorteada(f, p);
+                char ancora = "imf"[sorteiaInteiro(0, 2)];
+                fprintf(f, " %c %s", ancora, ESCOLHE(TEXTOS));
+                break;
+            }
+        }
+        fputc('\n', f);
+    }
+
+    free(centros);
+}
+
+
+/*________________________________ .QRY ________________________________*/
+
+// escreve " x y" com um ponto sorteado dentro da região
+static void escrevePontoSorteado(FILE *f, const Parametros *p) {
+    double x = sorteiaEntre(0.0, p->largura);
+    double y = sorteiaEntre(0.0, p->altura);
+    fprintf(f, " %.1f %.1f", x, y);
+}
+
+static void geraQry(FILE *f, const Parametros *p) {
+    int d = p->numDisparadores;
+    long numCarregadores = 2L * d;
+
+    // cada disparador começa posicionado e com dois carregadores cheios
+    for (int k = 1; k <= d; k++) {
+        fprintf(f, "pd %d", k);
+        escrevePontoSorteado(f, p);
+        fputc('\n', f);
+        fprintf(f, "lc %d %ld\n", 2 * k, sorteiaInteiro(0, p->cargaMaxima));
+        fprintf(f, "lc %d %ld\n", 2 * k + 1, sorteiaInteiro(0, p->cargaMaxima));
+        fprintf(f, "atch %d %d %d\n", k, 2 * k, 2 * k + 1);
+    }
+
+    double alcanceX = p->largura / 4.0;
+    double alcanceY = p->altura / 4.0;
+
+    for (long c = 0; c < p->numComandos; c++) {
+        long disp = sorteiaInteiro(1, d);
+        char lado = "ed"[sorteiaInteiro(0, 1)];
+
+        switch (sorteiaPeso(p->pesosComandos, NUM_COMANDOS)) {
+            case CMD_PD:
+                fprintf(f, "pd %ld", disp);
+                escrevePontoSorteado(f, p);
+                fputc('\n', f);
+                break;
+            case CMD_LC: {
+                long carregador = sorteiaInteiro(2, numCarregadores + 1);
+                fprintf(f, "lc %ld %ld\n", carregador, sorteiaInteiro(0, p->cargaMaxima));
+                break;
+            }
+            case CMD_ATCH: {
+                long esq = sorteiaInteiro(2, numCarregadores + 1);
+                long dir = sorteiaInteiro(2, numCarregadores + 1);
+                fprintf(f, "atch %ld %ld %ld\n", disp, esq, dir);
+                break;
+            }
+            case CMD_SHFT:
+                fprintf(f, "shft %ld %c %ld\n", disp, lado, sorteiaInteiro(1, 7));
+                break;
+            case CMD_DSP: {
+                static const char *flags[] = { "", " v", " i" };
+                double dx = sorteiaEntre(-alcanceX, alcanceX);
+                double dy = sorteiaEntre(-alcanceY, alcanceY);
+                fprintf(f, "dsp %ld %.1f %.1f%s\n", disp, dx, dy, ESCOLHE(flags));
+                break;
+            }
+            case CMD_RJD: {
+                double dx = sorteiaEntre(-alcanceX, alcanceX) / 4.0;
+                double dy = sorteiaEntre(-alcanceY, alcanceY) / 4.0;
+                double ix = sorteiaEntre(-10.0, 10.0);
+                double iy = sorteiaEntre(-10.0, 10.0);
+                fprintf(f, "rjd %ld %c %.1f %.1f %.1f %.1f\n", disp, lado, dx, dy, ix, iy);
+                break;
+            }
+            default:
+                fputs("calc\n", f);
+                break;
+        }
+    }
+    // a arena termina sempre processada
+    fputs("calc\n", f);
+}
+
+
+/*________________________________ PARÂMETROS ________________________________*/
+
+static void uso(const char *programa) {
+    fprintf(stderr,
+        "uso: %s -o <prefixo> [opções]\n"
+        "  -s <semente>          semente do sorteio (1)\n"
+        "  -n <formas>           formas no .geo (1000)\n"
+        "  -mix <c,r,l,t>        pesos dos tipos de forma (30,30,20,20)\n"
+        "  -ts <p>               chance de um 'ts' antes de cada forma (0.05)\n"
+        "  -cores <k>            quantidade de cores diferentes (8)\n"
+        "  -dist <tipo>          uniforme, aglomerada ou grade (uniforme)\n"
+        "  -aglomerados <k>      centros da distribuição aglomerada (10)\n"
+        "  -area <larg,alt>      região das formas (1555,810)\n"
+        "  -densidade <d>        formas cobrindo um ponto, em média (1.0)\n"
+        "  -disparadores <d>     disparadores no .qry (5)\n"
+        "  -comandos <m>         comandos sorteados no .qry (n/5)\n"
+        "  -mixqry <pd,lc,atch,shft,dsp,rjd,calc>\n"
+        "                        pesos dos comandos (5,10,5,25,35,10,10)\n"
+        "  -carga <k>            máximo de formas por 'lc' (n/(4d))\n",
+        programa);
+    exit(EXIT_FAILURE);
+}
+
+static double leReal(const char *programa, const char *arg, double minimo) {
+    char *fim;
+    double v = strtod(arg, &fim);
+    if (fim == arg || *fim != '\0' || !(v >= minimo)) {
+        fprintf(stderr, "ERRO: valor invalido: %s\n", arg);
+        uso(programa);
+    }
+    return v;
+}
+
+static long leInteiro(const char *programa, const char *arg, long minimo) {
+    char *fim;
+    long v = strtol(arg, &fim, 10);
+    if (fim == arg || *fim != '\0' || v < minimo) {
+        fprintf(stderr, "ERRO: valor invalido: %s\n", arg);
+        uso(programa);
+    }
+    return v;
+}
+
+// lê 'n' reais não negativos separados por vírgula
+static void leLista(const char *programa, const char *arg, double *destino, int n) {
+    const char *p = arg;
+    double soma = 0.0;
+    for (int i = 0; i < n; i++) {
+        char *fim;
+        destino[i] = strtod(p, &fim);
+        if (fim == p || !(destino[i] >= 0.0) || (i < n - 1 ? *fim != ',' : *fim != '\0')) {
+            fprintf(stderr, "ERRO: lista invalida (esperados %d valores): %s\n", n, arg);
+            uso(programa);
+        }
+        soma += destino[i];
+        p = fim + 1;
+    }
+    if (!(soma > 0.0)) {
+        fprintf(stderr, "ERRO: a soma dos pesos deve ser positiva: %s\n", arg);
+        uso(programa);
+    }
+}
+
+static void leParametros(int argc, char *argv[], Parametros *p) {
+    static const double pesosFormas[4] = { 30, 30, 20, 20 };
+    static const double pesosComandos[NUM_COMANDOS] = { 5, 10, 5, 25, 35, 10, 10 };
+
+    memset(p, 0, sizeof(*p));
+    p->semente = 1;
+    p->numFormas = 1000;
+    memcpy(p->pesosFormas, pesosFormas, sizeof(pesosFormas));
+    p->frequenciaTs = 0.05;
+    p->numCores = NUM_CORES_NOMEADAS;
+    p->distribuicao = DIST_UNIFORME;
+    p->numAglomerados = 10;
+    p->largura = LARGURA_PADRAO;
+    p->altura = ALTURA_PADRAO;
+    p->densidade = 1.0;
+    p->numDisparadores = 5;
+    p->numComandos = -1;
+    memcpy(p->pesosComandos, pesosComandos, sizeof(pesosComandos));
+    p->cargaMaxima = -1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opcao = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "ERRO: o parametro %s requer um valor.\n", opcao);
+            uso(argv[0]);
+        }
+        const char *valor = argv[++i];
+
+        if (strcmp(opcao, "-o") == 0) {
+            p->prefixo = valor;
+        } else if (strcmp(opcao, "-s") == 0) {
+            p->semente = (uint64_t) strtoull(valor, NULL, 10);
+        } else if (strcmp(opcao, "-n") == 0) {
+            p->numFormas = leInteiro(argv[0], valor, 1);
+        } else if (strcmp(opcao, "-mix") == 0) {
+            leLista(argv[0], valor, p->pesosFormas, 4);
+        } else if (strcmp(opcao, "-ts") == 0) {
+            p->frequenciaTs = leReal(argv[0], valor, 0.0);
+        } else if (strcmp(opcao, "-cores") == 0) {
+            p->numCores = (int) leInteiro(argv[0], valor, 1);
+        } else if (strcmp(opcao, "-dist") == 0) {
+            if (strcmp(valor, "uniforme") == 0) p->distribuicao = DIST_UNIFORME;
+            else if (strcmp(valor, "aglomerada") == 0) p->distribuicao = DIST_AGLOMERADA;
+            else if (strcmp(valor, "grade") == 0) p->distribuicao = DIST_GRADE;
+            else {
+                fprintf(stderr, "ERRO: distribuicao invalida: %s\n", valor);
+                uso(argv[0]);
+            }
+        } else if (strcmp(opcao, "-aglomerados") == 0) {
+            p->numAglomerados = (int) leInteiro(argv[0], valor, 1);
+        } else if (strcmp(opcao, "-area") == 0) {
+            double area[2];
+            leLista(argv[0], valor, area, 2);
+            if (!(area[0] > 0.0) || !(area[1] > 0.0)) {
+                fprintf(stderr, "ERRO: area invalida: %s\n", valor);
+                uso(argv[0]);
+            }
+            p->largura = area[0];
+            p->altura = area[1];
+        } else if (strcmp(opcao, "-densidade") == 0) {
+            p->densidade = leReal(argv[0], valor, 0.0);
+        } else if (strcmp(opcao, "-disparadores") == 0) {
+            p->numDisparadores = (int) leInteiro(argv[0], valor, 1);
+        } else if (strcmp(opcao, "-comandos") == 0) {
+            p->numComandos = leInteiro(argv[0], valor, 0);
+        } else if (strcmp(opcao, "-mixqry") == 0) {
+            leLista(argv[0], valor, p->pesosComandos, NUM_COMANDOS);
+        } else if (strcmp(opcao, "-carga") == 0) {
+            p->cargaMaxima = leInteiro(argv[0], valor, 0);
+        } else {
+            fprintf(stderr, "ERRO: parametro desconhecido: %s\n", opcao);
+            uso(argv[0]);
+        }
+    }
+
+    if (p->prefixo == NULL) {
+        uso(argv[0]);
+    }
+    if (p->numComandos < 0) {
+        p->numComandos = p->numFormas / 5;
+    }
+    if (p->cargaMaxima < 0) {
+        p->cargaMaxima = p->numFormas / (4L * p->numDisparadores);
+    }
+}
+
+static FILE *abreSaida(const char *prefixo, const char *extensao) {
+    size_t tam = strlen(prefixo) + strlen(extensao) + 1;
+    char *caminho = (char*) malloc(tam);
+    if (caminho == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    snprintf(caminho, tam, "%s%s", prefixo, extensao);
+    FILE *f = fopen(caminho, "w");
+    if (f == NULL) {
+        fprintf(stderr, "ERRO: nao foi possivel criar %s\n", caminho);
+        exit(EXIT_FAILURE);
+    }
+    free(caminho);
+    return f;
+}
+
+int main(int argc, char *argv[]) {
+    Parametros p;
+    leParametros(argc, argv, &p);
+
+    // .geo e .qry saem de sequências independentes, então mudar só as opções
+    // do .qry não muda o .geo gerado com a mesma semente
+    FILE *geo = abreSaida(p.prefixo, ".geo");
+    estado = p.semente;
+    geraGeo(geo, &p);
+    fclose(geo);
+
+    FILE *qry = abreSaida(p.prefixo, ".qry");
+    estado = p.semente ^ 0xD1B54A32D192ED03ULL;
+    geraQry(qry, &p);
+    fclose(qry);
+
+    return EXIT_SUCCESS;
+}
@@ -1,4 +1,6 @@
 #include "circulo.h"
+#include "memoriaFormas.h"
+#include "cores.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,8 +14,8 @@ typedef struct circulo {
     double x;         // coordenada X do centro
     double y;         // coordenada Y do centro
     double r;         // raio
-    char *corb;       // cor da borda
-    char *corp;       // cor de preenchimento
+    IdCor corb;       // cor da borda (tabela de cores)
+    IdCor corp;       // cor de preenchimento (tabela de cores)
     double sw;        // largura do traço (stroke-width)
     bool disp;        // flag de disparo
     int n;            // identificador de seleção
@@ -28,7 +30,7 @@ Circulo criarCirculo(int i, double x, double y, double r, char *corb, char *corp
         return NULL;
     }
     
-    circuloC *c = (circuloC*) malloc(sizeof(circuloC));
+    circuloC *c = (circuloC*) alocaMemoriaForma(sizeof(circuloC));
     if (c == NULL) {
         printf("Erro: falha na alocação de memória.\n");
         exit(1);
@@ -39,22 +41,8 @@ Circulo criarCirculo(int i, double x, double y, double r, char *corb, char *corp
     c->y = y;
     c->r = r;
     
-    c->corb = (char*) malloc((strlen(corb) + 1) * sizeof(char));
-    if (c->corb == NULL) {
-        free(c);
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(c->corb, corb);
-    
-    c->corp = (char*) malloc((strlen(corp) + 1) * sizeof(char));
-    if (c->corp == NULL) {
-        free(c->corb);
-        free(c);
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(c->corp, corp);
+    c->corb = (corb != NULL) ? internaCor(corb) : COR_INDEFINIDA;
+    c->corp = (corp != NULL) ? internaCor(corp) : COR_INDEFINIDA;
     
     c->sw = 1.0;      
     c->disp = disp;
@@ -68,9 +56,7 @@ void destroiCirculo(Circulo c) {
         return;
     }
     circuloC *circ = (circuloC*) c;
-    free(circ->corb);
-    free(circ->corp);
-    free(circ);
+    liberaMemoriaForma(circ);
 }
 
 /*           MÉTODOS GET (CONSULTA)  */
@@ -98,10 +84,20 @@ double getRCirculo(Circulo c) {
 
 char* getCorbCirculo(Circulo c) {
     circuloC *circ = (circuloC*) c;
-    return circ->corb;
+    return (char*) getNomeCor(circ->corb);
 }
 
 char* getCorpCirculo(Circulo c) {
+    circuloC *circ = (circuloC*) c;
+    return (char*) getNomeCor(circ->corp);
+}
+
+IdCor getIdCorbCirculo(Circulo c) {
+    circuloC *circ = (circuloC*) c;
+    return circ->corb;
+}
+
+IdCor getIdCorpCirculo(Circulo c) {
     circuloC *circ = (circuloC*) c;
     return circ->corp;
 }
@@ -144,24 +140,22 @@ void setRCirculo(Circulo c, double r) {
 
 void setCorbCirculo(Circulo c,const char* corb) {
     circuloC *circ = (circuloC*) c;
-    free(circ->corb);
-    circ->corb = (char*) malloc((strlen(corb) + 1) * sizeof(char));
-    if (circ->corb == NULL) {
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(circ->corb, corb);
+    circ->corb = internaCor(corb);
 }
 
 void setCorpCirculo(Circulo c, const char* corp) {
     circuloC *circ = (circuloC*) c;
-    free(circ->corp);
-    circ->corp = (char*) malloc((strlen(corp) + 1) * sizeof(char));
-    if (circ->corp == NULL) {
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(circ->corp, corp);
+    circ->corp = internaCor(corp);
+}
+
+void setIdCorbCirculo(Circulo c, IdCor corb) {
+    circuloC *circ = (circuloC*) c;
+    circ->corb = corb;
+}
+
+void setIdCorpCirculo(Circulo c, IdCor corp) {
+    circuloC *circ = (circuloC*) c;
+    circ->corp = corp;
 }
 
 void setSWCirculo(Circulo c, double sw) {
@@ -212,19 +206,25 @@ bool circulosIntersectam(Circulo c1, Circulo c2) {
     return distanciaCentros <= somaRaios;
 }
 
-void imprimeCirculoSVG(Circulo c, FILE *arquivo) {
-    if (c == NULL || arquivo == NULL) {
+void imprimeCirculoSVG(Circulo c, EscritorSvg svg) {
+    if (c == NULL || svg == NULL) {
         return;
     }
     
     circuloC *circ = (circuloC *)c;
     
-fprintf(arquivo, "  <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.2f\" ",
-        circ->x, circ->y, circ->r);
-
-fprintf(arquivo, "stroke=\"%s\" fill=\"%s\" fill-opacity=\"0.5\" ",
-        circ->corb, circ->corp);
-
-fprintf(arquivo, "stroke-width=\"%.2f\"/>\n",
-        circ->sw);
+    escreveStrSvg(svg, "  <circle cx=\"");
+    escreveDecimalSvg(svg, circ->x);
+    escreveStrSvg(svg, "\" cy=\"");
+    escreveDecimalSvg(svg, circ->y);
+    escreveStrSvg(svg, "\" r=\"");
+    escreveDecimalSvg(svg, circ->r);
+
+    escreveStrSvg(svg, "\" stroke=\"");
+    escreveStrSvg(svg, getNomeCor(circ->corb));
+    escreveStrSvg(svg, "\" fill=\"");
+    escreveStrSvg(svg, getNomeCor(circ->corp));
+    escreveStrSvg(svg, "\" fill-opacity=\"0.5\" stroke-width=\"");
+    escreveDecimalSvg(svg, circ->sw);
+    escreveStrSvg(svg, "\"/>\n");
 }
\ No newline at end of file
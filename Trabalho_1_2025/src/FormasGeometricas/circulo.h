@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "cores.h"
+#include "escritorSvg.h"
+
 /*
 *        TIPO ABSTRATO DE DADOS: CIRCULO
 *
@@ -37,6 +40,7 @@ agrupamento ou filtragem de círculos.
 *        r : raio do círculo em unidades de medida (deve ser > 0)
 *        corb: string representando a cor da borda/contorno do círculo
 *        corp: string representando a cor de preenchimento interno do círculo
+*              (corb/corp NULL: a cor fica COR_INDEFINIDA até setIdCorb/setIdCorpCirculo)
 *        disp: flag booleana indicando se o círculo foi disparado/ativado
 *
 *       Pré-condição: o raio r > 0 para formar um círculo válido
@@ -101,6 +105,10 @@ char* getCorbCirculo(Circulo c);
 //Retorna a cor de preenchimento do círculo, definindo a aparência do interior do círculo quando renderizado.
 char* getCorpCirculo(Circulo c);
 
+//Retornam os identificadores (tabela de cores) da cor da borda e da cor de preenchimento.
+IdCor getIdCorbCirculo(Circulo c);
+IdCor getIdCorpCirculo(Circulo c);
+
 /*
 Retorna a largura do traço da borda (stroke-width), ou seja a espessura da linha
 que forma o contorno do círculo. Quanto maior o valor, mais grossa a borda, e sempre >=0.
@@ -162,6 +170,10 @@ void setCorbCirculo(Circulo c,const char* corb);
 //Define a cor de preenchimento interno, modificando a aparência do interior do círculo.
 void setCorpCirculo(Circulo c,const char* corp);
 
+//Definem as cores a partir de identificadores já cadastrados na tabela de cores, sem consultar nomes.
+void setIdCorbCirculo(Circulo c, IdCor corb);
+void setIdCorpCirculo(Circulo c, IdCor corp);
+
 /*
 Define a largura do traço da borda (pré-requisito: sw >= 0).
 Esta operação controla a espessura da linha que forma o contorno,
@@ -241,12 +253,12 @@ com as cores, âncora e estilo tipográfico definidos. A âncora é convertida
 automaticamente para o formato SVG ('i'→"start", 'm'→"middle", 'f'→"end").
 
 *        c: ponteiro opaco para o circulo a ser renderizado
-*        arquivo: ponteiro para FILE aberto para escrita em modo SVG
+*        svg: escritor SVG de destino (escritorSvg.h)
 *
 *        Pré-condição: c deve ser um ponteiro válido para Circulo,
-*                      arquivo deve ser um FILE* válido aberto para escrita
+*                      svg deve ser um escritor válido
 */
-void imprimeCirculoSVG(Circulo c, FILE *arquivo);
+void imprimeCirculoSVG(Circulo c, EscritorSvg svg);
 
 
 #endif
@@ -0,0 +1,120 @@
+#include "cores.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// tamanho inicial do índice de espalhamento (sempre potência de 2)
+#define CAPACIDADE_INICIAL_INDICE 64
+
+// vazio no índice de espalhamento
+#define SEM_COR -1
+
+// tabela global: vetor de nomes (posição = IdCor) e índice de espalhamento
+// com endereçamento aberto que aponta para posições desse vetor
+static char **nomes = NULL;
+static int numCores = 0;
+static int capacidadeNomes = 0;
+
+static IdCor *indice = NULL;
+static int capacidadeIndice = 0;
+
+// FNV-1a
+static unsigned int espalhaNome(const char *nome) {
+    unsigned int h = 2166136261u;
+    while (*nome) {
+        h ^= (unsigned char) *nome++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// posição do índice onde está 'nome', ou a posição vazia onde ele entraria
+static int buscaIndice(const char *nome, unsigned int h) {
+    int mascara = capacidadeIndice - 1;
+    int pos = (int) (h & (unsigned int) mascara);
+    while (indice[pos] != SEM_COR && strcmp(nomes[indice[pos]], nome) != 0) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+// dobra o índice e reinsere todas as cores
+static void cresceIndice() {
+    int novaCapacidade = (capacidadeIndice == 0) ? CAPACIDADE_INICIAL_INDICE : capacidadeIndice * 2;
+    IdCor *novo = (IdCor*) malloc(novaCapacidade * sizeof(IdCor));
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (int i = 0; i < novaCapacidade; i++) {
+        novo[i] = SEM_COR;
+    }
+
+    free(indice);
+    indice = novo;
+    capacidadeIndice = novaCapacidade;
+
+    for (IdCor c = 0; c < numCores; c++) {
+        indice[buscaIndice(nomes[c], espalhaNome(nomes[c]))] = c;
+    }
+}
+
+IdCor internaCor(const char *nome) {
+    if (nome == NULL) {
+        nome = "";
+    }
+
+    // mantém o índice no máximo meio cheio
+    if (2 * (numCores + 1) > capacidadeIndice) {
+        cresceIndice();
+    }
+
+    int pos = buscaIndice(nome, espalhaNome(nome));
+    if (indice[pos] != SEM_COR) {
+        return indice[pos];
+    }
+
+    if (numCores == capacidadeNomes) {
+        int novaCapacidade = (capacidadeNomes == 0) ? 16 : capacidadeNomes * 2;
+        char **novo = (char**) realloc(nomes, novaCapacidade * sizeof(char*));
+        if (novo == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+        nomes = novo;
+        capacidadeNomes = novaCapacidade;
+    }
+
+    char *copia = (char*) malloc(strlen(nome) + 1);
+    if (copia == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    strcpy(copia, nome);
+
+    IdCor nova = numCores++;
+    nomes[nova] = copia;
+    indice[pos] = nova;
+    return nova;
+}
+
+const char *getNomeCor(IdCor cor) {
+    if (cor < 0 || cor >= numCores) {
+        return "";
+    }
+    return nomes[cor];
+}
+
+void liberaTabelaCores() {
+    for (IdCor c = 0; c < numCores; c++) {
+        free(nomes[c]);
+    }
+    free(nomes);
+    free(indice);
+    nomes = NULL;
+    indice = NULL;
+    numCores = 0;
+    capacidadeNomes = 0;
+    capacidadeIndice = 0;
+}
@@ -0,0 +1,58 @@
+#ifndef CORES_H
+#define CORES_H
+
+/*_______________________ MÓDULO: TABELA DE CORES _______________________*/
+/*
+* As entradas usam poucas cores distintas, repetidas em milhares de formas.
+* Este módulo guarda cada nome de cor uma única vez (tabela global) e
+* entrega um identificador inteiro (IdCor) para ele. As formas guardam
+* apenas esses identificadores; trocar uma cor é uma atribuição de inteiro
+* e o nome só é consultado na hora de escrever a saída.
+*
+* - Dois nomes iguais sempre recebem o mesmo IdCor.
+* - Os nomes retornados pertencem à tabela e não devem ser liberados.
+*/
+
+typedef int IdCor;
+
+/*
+IdCor de uma cor ainda não definida. Os construtores das formas o usam
+quando recebem NULL no lugar do nome, para quem já tem o IdCor e vai
+atribuí-lo logo depois (setIdCor*), sem passar pela tabela.
+*/
+#define COR_INDEFINIDA (-1)
+
+
+/*
+Retorna o identificador da cor com o nome dado, cadastrando o nome na
+tabela se ele ainda não existir.
+
+* nome: nome da cor (ex: "red", "#ff0000").
+*
+* Pré-condição: 'nome' deve ser uma string válida.
+* Pós-condição: Retorna o IdCor do nome; chamadas com o mesmo nome
+* retornam sempre o mesmo valor.
+*/
+IdCor internaCor(const char *nome);
+
+/*
+Retorna o nome de uma cor cadastrada.
+
+* cor: identificador retornado por 'internaCor'.
+*
+* Pré-condição: Nenhuma.
+* Pós-condição: Retorna o nome da cor (memória da tabela). Para
+* COR_INDEFINIDA ou um identificador inexistente retorna "" (nunca NULL),
+* de modo que o resultado pode ir direto para escreveStrSvg/fprintf.
+*/
+const char *getNomeCor(IdCor cor);
+
+/*
+Libera toda a memória da tabela de cores.
+
+* Pré-condição: Nenhum IdCor ou nome obtido antes deve ser usado depois.
+* Pós-condição: A tabela fica vazia, pronta para ser usada de novo.
+*/
+void liberaTabelaCores();
+
+#endif
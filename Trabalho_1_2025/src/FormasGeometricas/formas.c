@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "formas.h"
+#include "memoriaFormas.h"
 
 #include "circulo.h"
 #include "retangulo.h"
@@ -12,16 +13,17 @@
 /*_______________________ ESTRUTURA INTERNA DA FORMA GENÉRICA _______________________*/
 /*
 * Esta é a definição da nossa struct opaca. Ela é o "cérebro" do módulo.
+* A Forma é a própria célula de memoriaFormas (união marcada):
 * - 'id': Armazena o ID, que é um atributo comum a todas as formas.
 * - 'tipo': Usa o enum 'TipoForma' para identificar o que a forma realmente é.
-* - 'dados_especificos': O ponteiro void* que aponta para a struct da forma
-* específica (um Círculo, Retângulo, etc.).
+* - 'dados': A struct da forma específica (um Círculo, Retângulo, etc.),
+* guardada na mesma célula, logo depois do cabeçalho. Assim o invólucro
+* não precisa de alocação própria nem de um ponteiro para os dados.
 */
-typedef struct {
-    int id;
-    TipoForma tipo;
-    void *dados_especificos;
-} FormaInterno;
+typedef CelulaForma FormaInterno;
+
+// dados específicos guardados na célula (o Circulo, Retangulo, ... da forma)
+#define DADOS(forma) ((void*) (forma)->dados.bytes)
 
 
 /*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
@@ -32,17 +34,13 @@ Forma criaForma(int id, TipoForma tipo, void *dados_especificos) {
         return NULL;
     }
 
-    // Aloca memória para a nossa estrutura genérica (o "invólucro")
-    FormaInterno *f = (FormaInterno*) malloc(sizeof(FormaInterno));
-    if (!f) {
-        printf("\nERRO: Falha ao alocar memória para a forma genérica!\n");
-        return NULL;
-    }
+    // Os dados já foram criados dentro de uma célula (criarCirculo etc.);
+    // o invólucro é o cabeçalho dessa mesma célula
+    FormaInterno *f = getCelulaForma(dados_especificos);
 
     // Atribui os dados comuns ao invólucro
     f->id = id;
     f->tipo = tipo;
-    f->dados_especificos = dados_especificos;
 
     return (Forma)f;
 }
@@ -54,24 +52,34 @@ void destroiForma(Forma f) {
 
     FormaInterno *forma = (FormaInterno*)f;
 
-    // Antes de liberar o invólucro, precisamos liberar a forma específica que está dentro dele.
-    // Usamos o 'tipo' para saber qual função de destruição chamar.
+    // A destruição específica libera os recursos da forma e devolve a
+    // célula inteira (cabeçalho incluso). Usamos o 'tipo' para saber qual chamar.
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            destroiCirculo(forma->dados_especificos);
+            destroiCirculo(DADOS(forma));
             break;
         case TIPO_RETANGULO:
-            destroiRetangulo(forma->dados_especificos);
+            destroiRetangulo(DADOS(forma));
             break;
         case TIPO_LINHA:
-            destroiLinha(forma->dados_especificos);
+            destroiLinha(DADOS(forma));
             break;
         case TIPO_TEXTO:
-            destroiTexto(forma->dados_especificos);
+            destroiTexto(DADOS(forma));
             break;
     }
+}
+
+void descartaForma(Forma f) {
+    if (!f) {
+        return;
+    }
 
-    free(forma);
+    // círculos, retângulos e linhas cabem inteiros na célula
+    FormaInterno *forma = (FormaInterno*)f;
+    if (forma->tipo == TIPO_TEXTO) {
+        descartaTexto(DADOS(forma));
+    }
 }
 
 
@@ -104,13 +112,13 @@ double getFormaX(const Forma f) {
     // chama função getX específica de cada tipo de forma
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            return getXCirculo(forma->dados_especificos);
+            return getXCirculo(DADOS(forma));
         case TIPO_RETANGULO: 
-            return getXRetangulo(forma->dados_especificos);
+            return getXRetangulo(DADOS(forma));
         case TIPO_LINHA:     
-            return getX1Linha(forma->dados_especificos); // Âncora da linha é o ponto 1
+            return getX1Linha(DADOS(forma)); // Âncora da linha é o ponto 1
         case TIPO_TEXTO:     
-            return getXTexto(forma->dados_especificos);
+            return getXTexto(DADOS(forma));
     }
     return 0.0;
 }
@@ -125,13 +133,13 @@ double getFormaY(const Forma f) {
     // chama a função getY específica de cada tipo de forma
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            return getYCirculo(forma->dados_especificos);
+            return getYCirculo(DADOS(forma));
         case TIPO_RETANGULO: 
-            return getYRetangulo(forma->dados_especificos);
+            return getYRetangulo(DADOS(forma));
         case TIPO_LINHA:     
-            return getY1Linha(forma->dados_especificos);
+            return getY1Linha(DADOS(forma));
         case TIPO_TEXTO:     
-            return getYTexto(forma->dados_especificos);
+            return getYTexto(DADOS(forma));
     }
     return 0.0;
 }
@@ -145,13 +153,13 @@ char *getFormaCorBorda(const Forma f) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            return getCorbCirculo(forma->dados_especificos);
+            return getCorbCirculo(DADOS(forma));
         case TIPO_RETANGULO: 
-            return getCorbRetangulo(forma->dados_especificos);
+            return getCorbRetangulo(DADOS(forma));
         case TIPO_LINHA:     
-            return getCorLinha(forma->dados_especificos); // Linha só tem uma cor
+            return getCorLinha(DADOS(forma)); // Linha só tem uma cor
         case TIPO_TEXTO:     
-            return getCorbTexto(forma->dados_especificos);
+            return getCorbTexto(DADOS(forma));
     }
     return NULL;
 }
@@ -165,24 +173,64 @@ char *getFormaCorPreenchimento(const Forma f) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            return getCorpCirculo(forma->dados_especificos);
+            return getCorpCirculo(DADOS(forma));
         case TIPO_RETANGULO: 
-            return getCorpRetangulo(forma->dados_especificos);
+            return getCorpRetangulo(DADOS(forma));
         case TIPO_LINHA:     
-            return getCorLinha(forma->dados_especificos); // Linha não tem preenchimento, retornar a cor principal
+            return getCorLinha(DADOS(forma)); // Linha não tem preenchimento, retornar a cor principal
         case TIPO_TEXTO:     
-            return getCorpTexto(forma->dados_especificos);
+            return getCorpTexto(DADOS(forma));
     }
     return NULL;
 }
 
+IdCor getFormaIdCorBorda(const Forma f) {
+    if (!f) {
+        return -1;
+    }
+
+    FormaInterno *forma = (FormaInterno*)f;
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:   
+            return getIdCorbCirculo(DADOS(forma));
+        case TIPO_RETANGULO: 
+            return getIdCorbRetangulo(DADOS(forma));
+        case TIPO_LINHA:     
+            return getIdCorLinha(DADOS(forma));
+        case TIPO_TEXTO:     
+            return getIdCorbTexto(DADOS(forma));
+    }
+    return -1;
+}
+
+IdCor getFormaIdCorPreenchimento(const Forma f) {
+    if (!f) {
+        return -1;
+    }
+
+    FormaInterno *forma = (FormaInterno*)f;
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:   
+            return getIdCorpCirculo(DADOS(forma));
+        case TIPO_RETANGULO: 
+            return getIdCorpRetangulo(DADOS(forma));
+        case TIPO_LINHA:     
+            return getIdCorLinha(DADOS(forma));
+        case TIPO_TEXTO:     
+            return getIdCorpTexto(DADOS(forma));
+    }
+    return -1;
+}
+
 void* getFormaAssoc(const Forma f) {
     if (!f) {
         return NULL;
     }
     
     FormaInterno *forma = (FormaInterno*)f;
-    return forma->dados_especificos;
+    return DADOS(forma);
 }
 
 double getFormaArea(const Forma f) {
@@ -194,19 +242,19 @@ double getFormaArea(const Forma f) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            return calculaAreaCirculo(forma->dados_especificos);
+            return calculaAreaCirculo(DADOS(forma));
             
         case TIPO_RETANGULO:
-            return calculaAreaRetangulo(forma->dados_especificos);
+            return calculaAreaRetangulo(DADOS(forma));
             
         case TIPO_LINHA: {
-            Linha l = forma->dados_especificos;
+            Linha l = DADOS(forma);
             double comprimento = calculaComprimentoLinha(l);
             return 2.0 * comprimento;  //conforme o especificad
         }
             
         case TIPO_TEXTO: {
-            Texto t = forma->dados_especificos;
+            Texto t = DADOS(forma);
             char *str = getTexto(t);
 
             if (str == NULL) return 0.0;
@@ -229,31 +277,31 @@ void setFormaPosicao(Forma f, double x, double y) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:
-            setXCirculo(forma->dados_especificos, x);
-            setYCirculo(forma->dados_especificos, y);
+            setXCirculo(DADOS(forma), x);
+            setYCirculo(DADOS(forma), y);
             break;
         case TIPO_RETANGULO:
-            setXRetangulo(forma->dados_especificos, x);
-            setYRetangulo(forma->dados_especificos, y);
+            setXRetangulo(DADOS(forma), x);
+            setYRetangulo(DADOS(forma), y);
             break;
         case TIPO_TEXTO:
-            setXTexto(forma->dados_especificos, x);
-            setYTexto(forma->dados_especificos, y);
+            setXTexto(DADOS(forma), x);
+            setYTexto(DADOS(forma), y);
             break;
         case TIPO_LINHA: {
             // Mover uma linha significa transladar ambos os pontos
-            double x1_antigo = getX1Linha(forma->dados_especificos);
-            double y1_antigo = getY1Linha(forma->dados_especificos);
+            double x1_antigo = getX1Linha(DADOS(forma));
+            double y1_antigo = getY1Linha(DADOS(forma));
             double dx = x - x1_antigo;
             double dy = y - y1_antigo;
 
-            double x2_antigo = getX2Linha(forma->dados_especificos);
-            double y2_antigo = getY2Linha(forma->dados_especificos);
+            double x2_antigo = getX2Linha(DADOS(forma));
+            double y2_antigo = getY2Linha(DADOS(forma));
             
-            setX1Linha(forma->dados_especificos, x);
-            setY1Linha(forma->dados_especificos, y);
-            setX2Linha(forma->dados_especificos, x2_antigo + dx);
-            setY2Linha(forma->dados_especificos, y2_antigo + dy);
+            setX1Linha(DADOS(forma), x);
+            setY1Linha(DADOS(forma), y);
+            setX2Linha(DADOS(forma), x2_antigo + dx);
+            setY2Linha(DADOS(forma), y2_antigo + dy);
             break;
         }
     }
@@ -268,16 +316,16 @@ void setFormaCorBorda(Forma f, const char *corBorda) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:  
-            setCorbCirculo(forma->dados_especificos, corBorda); 
+            setCorbCirculo(DADOS(forma), corBorda); 
             break;
         case TIPO_RETANGULO: 
-            setCorbRetangulo(forma->dados_especificos, corBorda); 
+            setCorbRetangulo(DADOS(forma), corBorda); 
             break;
         case TIPO_LINHA:     
-            setCorLinha(forma->dados_especificos, corBorda); 
+            setCorLinha(DADOS(forma), corBorda); 
             break;
         case TIPO_TEXTO:     
-            setCorbTexto(forma->dados_especificos, corBorda); 
+            setCorbTexto(DADOS(forma), corBorda); 
             break;
     }
 }
@@ -291,16 +339,63 @@ void setFormaCorPreenchimento(Forma f, const char *corPreenchimento) {
 
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            setCorpCirculo(forma->dados_especificos, corPreenchimento);
+            setCorpCirculo(DADOS(forma), corPreenchimento);
+            break;
+        case TIPO_RETANGULO: 
+            setCorpRetangulo(DADOS(forma), corPreenchimento); 
+            break;
+        case TIPO_LINHA:     
+            setCorLinha(DADOS(forma), corPreenchimento); 
+            break;
+        case TIPO_TEXTO:     
+            setCorpTexto(DADOS(forma), corPreenchimento); 
+            break;
+    }
+}
+
+
+void setFormaIdCorBorda(Forma f, IdCor cor) {
+    if (!f) {
+        return;
+    }
+
+    FormaInterno *forma = (FormaInterno*)f;
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:  
+            setIdCorbCirculo(DADOS(forma), cor); 
+            break;
+        case TIPO_RETANGULO: 
+            setIdCorbRetangulo(DADOS(forma), cor); 
+            break;
+        case TIPO_LINHA:     
+            setIdCorLinha(DADOS(forma), cor); 
+            break;
+        case TIPO_TEXTO:     
+            setIdCorbTexto(DADOS(forma), cor); 
+            break;
+    }
+}
+
+void setFormaIdCorPreenchimento(Forma f, IdCor cor) {
+    if (!f) {
+        return;
+    }
+
+    FormaInterno *forma = (FormaInterno*)f;
+
+    switch (forma->tipo) {
+        case TIPO_CIRCULO:   
+            setIdCorpCirculo(DADOS(forma), cor);
             break;
         case TIPO_RETANGULO: 
-            setCorpRetangulo(forma->dados_especificos, corPreenchimento); 
+            setIdCorpRetangulo(DADOS(forma), cor); 
             break;
         case TIPO_LINHA:     
-            setCorLinha(forma->dados_especificos, corPreenchimento); 
+            setIdCorLinha(DADOS(forma), cor); 
             break;
         case TIPO_TEXTO:     
-            setCorpTexto(forma->dados_especificos, corPreenchimento); 
+            setIdCorpTexto(DADOS(forma), cor); 
             break;
     }
 }
@@ -308,8 +403,8 @@ void setFormaCorPreenchimento(Forma f, const char *corPreenchimento) {
 
 /*________________________________ FUNÇÕES DE RENDERIZAÇÃO ________________________________*/
 
-void desenhaForma(const Forma f, FILE *arquivoSvg) {
-    if (!f || !arquivoSvg) {
+void desenhaForma(const Forma f, EscritorSvg svg) {
+    if (!f || !svg) {
         return;
     }
 
@@ -318,16 +413,16 @@ void desenhaForma(const Forma f, FILE *arquivoSvg) {
     // Delega a chamada para a função de impressão SVG específica de cada tipo
     switch (forma->tipo) {
         case TIPO_CIRCULO:   
-            imprimeCirculoSVG(forma->dados_especificos, arquivoSvg); 
+            imprimeCirculoSVG(DADOS(forma), svg); 
             break;
         case TIPO_RETANGULO: 
-            imprimeRetanguloSVG(forma->dados_especificos, arquivoSvg); 
+            imprimeRetanguloSVG(DADOS(forma), svg); 
             break;
         case TIPO_LINHA:     
-            imprimeLinhaSVG(forma->dados_especificos, arquivoSvg); 
+            imprimeLinhaSVG(DADOS(forma), svg); 
             break;
         case TIPO_TEXTO:     
-            imprimeTextoSVG(forma->dados_especificos, arquivoSvg); 
+            imprimeTextoSVG(DADOS(forma), svg); 
             break;
     }
 }
\ No newline at end of file
@@ -14,9 +14,12 @@
 * Este módulo define uma interface genérica para manipular diferentes
 * tipos de objetos geométricos (círculos, retângulos, etc.) de forma
 * uniforme. A 'Forma' genérica funciona como um container que armazena
-* atributos comuns a todas as formas e aponta para os dados específicos.
+* atributos comuns a todas as formas junto dos dados específicos.
 *
 * - A definição completa da struct está encapsulada no arquivo .c
+* - Invólucro e dados específicos ocupam uma única célula do módulo
+* memoriaFormas: 'dados_especificos' de criaForma deve vir de um
+* construtor específico (criarCirculo etc.) e passa a pertencer à Forma.
 */
 
 typedef enum {
@@ -55,6 +58,18 @@ específica contida nela.
 */
 void destroiForma(Forma f);
 
+/*
+Versão de encerramento de 'destroiForma': libera só a memória que a forma
+tem fora da sua célula (hoje, apenas a dos textos) e deixa a célula para
+'liberaTodaMemoriaFormas' (memoriaFormas.h), que solta todas de uma vez.
+
+* f: A forma a ser descartada.
+*
+* Pós-condição: 'f' não pode mais ser usada; a célula só volta ao sistema
+* com 'liberaTodaMemoriaFormas'.
+*/
+void descartaForma(Forma f);
+
 
 /*________________________________ FUNÇÕES DE CONSULTA (GETTERS) ________________________________*/
 /*
@@ -117,6 +132,18 @@ Obtém a cor de preenchimento da forma.
 */
 char *getFormaCorPreenchimento(const Forma f);
 
+/*
+Obtém os identificadores (tabela de cores) da cor de borda e da cor de
+preenchimento da forma. Para linhas, ambos retornam a cor da linha.
+
+* f: Ponteiro para a forma.
+*
+* Pré-condição: 'f' deve ser um ponteiro válido.
+* Pós-condição: Retorna o IdCor correspondente, ou -1 se 'f' for nulo.
+*/
+IdCor getFormaIdCorBorda(const Forma f);
+IdCor getFormaIdCorPreenchimento(const Forma f);
+
 
 /*
 Obtém o ponteiro para os dados específicos da forma (o objeto Circulo, Retangulo, etc.).
@@ -174,17 +201,32 @@ Define a cor de preenchimento da forma.
 */
 void setFormaCorPreenchimento(Forma f, const char *corPreenchimento);
 
+/*
+Definem a cor de borda / de preenchimento a partir de um identificador já
+cadastrado na tabela de cores (apenas uma atribuição, sem consultar nomes).
+Para linhas, ambos alteram a cor da linha.
+
+* f: Ponteiro para a forma a ser modificada.
+* cor: Identificador da nova cor.
+*
+* Pré-condição: 'f' deve ser um ponteiro válido e 'cor' um IdCor válido.
+* Pós-condição: A cor correspondente da forma é atualizada.
+*/
+void setFormaIdCorBorda(Forma f, IdCor cor);
+void setFormaIdCorPreenchimento(Forma f, IdCor cor);
+
 
 /*________________________________ FUNÇÕES DE RENDERIZAÇÃO ________________________________*/
 /*
-Desenha a representação SVG da forma em um arquivo.
+Desenha a representação SVG da forma por meio de um escritor SVG.
 
 * f: Ponteiro para a forma a ser desenhada.
-* arquivoSvg: Ponteiro para o arquivo SVG aberto para escrita.
+* svg: Escritor SVG de destino (escritorSvg.h).
 *
-* Pré-condição: 'f' e 'arquivoSvg' devem ser ponteiros válidos.
-* Pós-condição: O código SVG correspondente à forma é escrito no arquivo.
+* Pré-condição: 'f' e 'svg' devem ser ponteiros válidos.
+* Pós-condição: O código SVG correspondente à forma é escrito no buffer
+* do escritor (e chega ao arquivo quando o escritor é descarregado).
 */
-void desenhaForma(const Forma f, FILE *arquivoSvg);
+void desenhaForma(const Forma f, EscritorSvg svg);
 
 #endif
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "linha.h"
+#include "memoriaFormas.h"
+#include "cores.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,17 +12,17 @@ typedef struct linha {
     double y1;
     double x2;
     double y2;
-    char *cor;
+    IdCor cor;  // id da tabela de cores
     double sw;
-    bool disp;
     int n;
-    bool pontilhada;
+    bool disp;
+    bool pontilhada;  // junto de 'disp' para a struct caber em uma célula de forma
 } linhaC;
 
 /*                                FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO                                */ 
 
 Linha criarLinha(int i, double x1, double y1, double x2, double y2, char *cor, bool disp, int n) {
-    linhaC *l = (linhaC*) malloc(sizeof(linhaC));
+    linhaC *l = (linhaC*) alocaMemoriaForma(sizeof(linhaC));
     if (l == NULL) {
         printf("Erro: falha na alocação de memória.\n");
         exit(1);
@@ -32,13 +34,7 @@ Linha criarLinha(int i, double x1, double y1, double x2, double y2, char *cor, b
     l->x2 = x2;
     l->y2 = y2;
     
-    l->cor = (char*) malloc((strlen(cor) + 1) * sizeof(char));
-    if (l->cor == NULL) {
-        free(l);
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(l->cor, cor);
+    l->cor = (cor != NULL) ? internaCor(cor) : COR_INDEFINIDA;
     
     l->sw = 1.0;     
     l->disp = disp;
@@ -53,8 +49,7 @@ void destroiLinha(Linha l) {
         return;
     }
     linhaC *linha = (linhaC*) l;
-    free(linha->cor);
-    free(linha);
+    liberaMemoriaForma(linha);
 }
 
 /*                                MÉTODOS GET                                */
@@ -80,6 +75,11 @@ double getY2Linha(Linha l) {
 }
 
 char* getCorLinha(Linha l) {
+    linhaC *linha = (linhaC*) l;
+    return (char*) getNomeCor(linha->cor);
+}
+
+IdCor getIdCorLinha(Linha l) {
     linhaC *linha = (linhaC*) l;
     return linha->cor;
 }
@@ -122,13 +122,12 @@ void setY2Linha(Linha l, double y) {
 
 void setCorLinha(Linha l, const char* cor) {
     linhaC *linha = (linhaC*) l;
-    free(linha->cor);
-    linha->cor = (char*) malloc((strlen(cor) + 1) * sizeof(char));
-    if (linha->cor == NULL) {
-        printf("Erro: falha na alocação de memória.\n");
-        exit(1);
-    }
-    strcpy(linha->cor, cor);
+    linha->cor = internaCor(cor);
+}
+
+void setIdCorLinha(Linha l, IdCor cor) {
+    linhaC *linha = (linhaC*) l;
+    linha->cor = cor;
 }
 
 void setSWLinha(Linha l, double sw) {
@@ -171,21 +170,32 @@ double calculaAreaLinha(Linha l) {
 
 /*                          RENDERIZACAO                    */
 
-void imprimeLinhaSVG(Linha l, FILE *arquivo) {
-    if (l == NULL || arquivo == NULL) {
+void imprimeLinhaSVG(Linha l, EscritorSvg svg) {
+    if (l == NULL || svg == NULL) {
         return;
     }
 
     linhaC *linha = (linhaC*) l;
 
     //imprime a tag <line> no arquivo SVG
-    fprintf(arquivo, "\t<line x1=\"%.2f\" y1=\"%.2f\" x2=\"%.2f\" y2=\"%.2f\" stroke=\"%s\" stroke-width=\"%.2f\"",
-            linha->x1, linha->y1, linha->x2, linha->y2, linha->cor, linha->sw);
+    escreveStrSvg(svg, "\t<line x1=\"");
+    escreveDecimalSvg(svg, linha->x1);
+    escreveStrSvg(svg, "\" y1=\"");
+    escreveDecimalSvg(svg, linha->y1);
+    escreveStrSvg(svg, "\" x2=\"");
+    escreveDecimalSvg(svg, linha->x2);
+    escreveStrSvg(svg, "\" y2=\"");
+    escreveDecimalSvg(svg, linha->y2);
+    escreveStrSvg(svg, "\" stroke=\"");
+    escreveStrSvg(svg, getNomeCor(linha->cor));
+    escreveStrSvg(svg, "\" stroke-width=\"");
+    escreveDecimalSvg(svg, linha->sw);
+    escreveCharSvg(svg, '"');
     
     //adiciona pontilhado se precisar
     if (linha->pontilhada) {
-        fprintf(arquivo, " stroke-dasharray=\"1,1\"");
+        escreveStrSvg(svg, " stroke-dasharray=\"1,1\"");
     }
     
-    fprintf(arquivo, " />\n");
+    escreveStrSvg(svg, " />\n");
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "cores.h"
+#include "escritorSvg.h"
+
 /*
 *        TIPO ABSTRATO DE DADOS: LINHA
 *
@@ -35,6 +38,7 @@ agrupamento ou filtragem de linhas.
 *        x1,y1 : coordenadas do ponto inicial da linha no sistema cartesiano  
 *        x2,y2 : coordenadas do ponto final da linha no sistema cartesiano  
 *        cor: string representando a cor do traço da linha
+*             (NULL: a cor fica COR_INDEFINIDA até setIdCorLinha)
 *        disp: flag booleana indicando se a linha foi disparada/ativada
 *        n : identificador numérico adicional para seleção ou agrupamento
 *
@@ -98,6 +102,9 @@ a string que representa a cor, permitindo uso direto em funções gráficas.
 */
 char* getCorLinha(Linha l);
 
+//Retorna o identificador (tabela de cores) da cor da linha.
+IdCor getIdCorLinha(Linha l);
+
 /*
 Retorna a largura do traço da borda (stroke-width), ou seja a espessura da linha.
 Quanto maior o valor, mais grossa a linha, e sempre >=0.
@@ -163,6 +170,9 @@ de estado.
 */
 void setCorLinha(Linha l,const char* cor);
 
+//Define a cor da linha a partir de um identificador já cadastrado na tabela de cores.
+void setIdCorLinha(Linha l, IdCor cor);
+
 /*
 Define a largura do traço (pré-requisito: sw >= 0).
 Esta operação controla a espessura da linha,
@@ -229,11 +239,11 @@ com as cores, âncora e estilo tipográfico definidos. A âncora é convertida
 automaticamente para o formato SVG ('i'→"start", 'm'→"middle", 'f'→"end").
 
 *        l: ponteiro opaco para a linha a ser renderizada
-*        arquivo: ponteiro para FILE aberto para escrita em modo SVG
+*        svg: escritor SVG de destino (escritorSvg.h)
 *
 *        Pré-condição: l deve ser um ponteiro válido para Linha,
-*                      arquivo deve ser um FILE* válido aberto para escrita
+*                      svg deve ser um escritor válido
 */
-void imprimeLinhaSVG(Linha l, FILE *arquivo);
+void imprimeLinhaSVG(Linha l, EscritorSvg svg);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "memoriaFormas.h"
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+// quantidade de células em cada bloco pedido ao sistema
+#define CELULAS_POR_BLOCO 4096
+
+// Pool único de células, criado na primeira alocação
+static Pool poolCelulas = NULL;
+
+#ifdef CONTABILMEMORIA_H
+// a definição abaixo é a da função, não a da macro
+#undef alocaMemoriaForma
+
+// os blocos do Pool são contados em pool.c, que repassa cada célula
+static int moduloPool = -1;
+// bytes de células repassados a cada módulo e ainda não devolvidos
+static size_t bytesRepassados[MAX_MODULOS_CONTABIL];
+#endif
+
+void *alocaMemoriaForma(size_t tamanho) {
+    if (tamanho > TAMANHO_DADOS_FORMA) {
+        printf("Erro: dados de forma com %zu bytes não cabem na célula (%d).\n",
+               tamanho, TAMANHO_DADOS_FORMA);
+        exit(1);
+    }
+    if (poolCelulas == NULL) {
+        poolCelulas = criaPool(sizeof(CelulaForma), CELULAS_POR_BLOCO);
+    }
+    CelulaForma *celula = (CelulaForma*) alocaObjetoPool(poolCelulas);
+    return celula->dados.bytes;
+}
+
+#ifdef CONTABILMEMORIA_H
+void *alocaMemoriaFormaContabil(size_t tamanho, const char *arquivo, int *modulo) {
+    void *dados = alocaMemoriaForma(tamanho);
+    CelulaForma *celula = getCelulaForma(dados);
+    celula->moduloContabil = moduloContabil(arquivo, modulo);
+
+    repassaContabil(moduloContabil("pool.c", &moduloPool), celula->moduloContabil, sizeof(CelulaForma));
+    bytesRepassados[celula->moduloContabil] += sizeof(CelulaForma);
+    return dados;
+}
+#endif
+
+void liberaMemoriaForma(void *dados) {
+    if (dados == NULL) {
+        return;
+    }
+#ifdef CONTABILMEMORIA_H
+    int usuario = getCelulaForma(dados)->moduloContabil;
+    devolveContabil(moduloPool, usuario, sizeof(CelulaForma));
+    bytesRepassados[usuario] -= sizeof(CelulaForma);
+#endif
+    liberaObjetoPool(poolCelulas, getCelulaForma(dados));
+}
+
+CelulaForma *getCelulaForma(void *dados) {
+    return (CelulaForma*) ((char*) dados - offsetof(CelulaForma, dados));
+}
+
+void liberaTodaMemoriaFormas() {
+#ifdef CONTABILMEMORIA_H
+    // as células ainda em uso voltam a pool.c antes de os blocos serem liberados
+    for (int i = 0; i < MAX_MODULOS_CONTABIL; i++) {
+        if (bytesRepassados[i] > 0) {
+            devolveContabil(moduloPool, i, bytesRepassados[i]);
+            bytesRepassados[i] = 0;
+        }
+    }
+#endif
+    destroiPool(poolCelulas);
+    poolCelulas = NULL;
+}
@@ -0,0 +1,84 @@
+#ifndef MEMORIAFORMAS_H
+#define MEMORIAFORMAS_H
+
+#include <stdlib.h>
+
+/*_______________________ MÓDULO: MEMÓRIA DAS FORMAS _______________________*/
+/*
+* Este módulo concentra a memória de todas as formas criadas durante uma
+* execução. Cada forma ocupa uma única célula de tamanho fixo, vinda de um
+* Pool: o cabeçalho da Forma genérica (id e tipo) e, logo em seguida, os
+* dados específicos do Círculo, Retângulo, Linha ou Texto (união marcada
+* pelo tipo).
+*
+* - Os construtores específicos (criarCirculo etc.) pedem aqui o espaço
+* dos seus dados; criaForma apenas preenche o cabeçalho da mesma célula,
+* então não há alocação nem ponteiro extra para o invólucro.
+* - Destruir uma forma apenas devolve a célula ao Pool.
+* - Ao final da execução, 'liberaTodaMemoriaFormas' devolve todos os
+* blocos ao sistema de uma só vez.
+*/
+
+// maior struct de dados específicos que cabe em uma célula
+#define TAMANHO_DADOS_FORMA 64
+
+typedef struct {
+    int id;
+    int tipo;  // TipoForma (formas.h)
+#ifdef CONTABILMEMORIA_H
+    int moduloContabil;  // módulo que criou a forma (só com make MEMORIA=1)
+#endif
+    union {
+        double alinhamento;
+        void *ponteiro;
+        unsigned char bytes[TAMANHO_DADOS_FORMA];
+    } dados;
+} CelulaForma;
+
+
+/*
+Entrega o espaço dos dados específicos de uma nova célula de forma.
+
+* tamanho: tamanho da estrutura (sizeof da struct interna do módulo).
+*
+* Pré-condição: tamanho <= TAMANHO_DADOS_FORMA.
+* Pós-condição: Retorna um ponteiro para memória não inicializada dentro
+* da célula; o programa é encerrado se não houver memória.
+*/
+void *alocaMemoriaForma(size_t tamanho);
+
+#ifdef CONTABILMEMORIA_H
+/*
+Com make MEMORIA=1 a célula é contada no módulo que criou a forma
+(circulo.c, retangulo.c, linha.c, texto.c), e não no pool.c que reservou
+o bloco; assim a tabela separa a memória por tipo de forma.
+*/
+void *alocaMemoriaFormaContabil(size_t tamanho, const char *arquivo, int *modulo);
+#define alocaMemoriaForma(tam) alocaMemoriaFormaContabil((tam), __FILE__, &contabilModuloLocal)
+#endif
+
+/*
+Devolve ao Pool a célula que contém os dados indicados.
+
+* dados: ponteiro entregue por 'alocaMemoriaForma'.
+*
+* Pós-condição: A célula fica disponível para a próxima alocação.
+*/
+void liberaMemoriaForma(void *dados);
+
+/*
+Retorna a célula que contém os dados indicados.
+
+* dados: ponteiro entregue por 'alocaMemoriaForma'.
+*/
+CelulaForma *getCelulaForma(void *dados);
+
+/*
+Libera de uma só vez toda a memória de formas da execução.
+
+* Pré-condição: Nenhuma forma deve ser usada depois desta chamada.
+* Pós-condição: Todos os blocos são devolvidos ao sistema.
+*/
+void liberaTodaMemoriaFormas();
+
+#endif
@@ -1,4 +1,6 @@
 #include "retangulo.h"
+#include "memoriaFormas.h"
+#include "cores.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,8 +12,8 @@ typedef struct retangulo{
     double y;
     double w; //deve ser >0
     double h; //deve ser >0
-    char *corb;
-    char *corp;
+    IdCor corb; //cores guardadas como id da tabela de cores
+    IdCor corp;
     double sw; //largura do traco
     bool disp;
     int n; 
@@ -24,7 +26,7 @@ Retangulo criarRetangulo(int i, double x, double y, double w, double h, char *co
         return NULL;
     }
 //alocar
-    retanguloR *r= (retanguloR*) malloc (sizeof(retanguloR));
+    retanguloR *r= (retanguloR*) alocaMemoriaForma(sizeof(retanguloR));
     if(r==NULL){
         printf("\n Erro na alocacao de memoria!!\n");
         exit(1);
@@ -37,24 +39,9 @@ Retangulo criarRetangulo(int i, double x, double y, double w, double h, char *co
     r->w = w;
     r->h = h;
 
-    //cor borda 
-    r->corb = (char*)malloc((strlen(corb) + 1) * sizeof(char));
-    if(r->corb ==NULL){ 
-        free(r);
-        printf("\n Erro na alocacao de memoria!!\n");
-        exit(1);
-    }
-    strcpy(r->corb, corb); //copiar como apenas corb
-    
-    //cor preenchemento
-    r->corp = (char*) malloc((strlen(corp) + 1) * sizeof(char));
-    if (r->corp == NULL) {
-        free(r->corb);
-        free(r);
-        printf("\n Erro na alocacao de memoria!!\n");
-        exit(1);
-    }
-    strcpy(r->corp, corp);
+    //cor borda e preenchimento: so o id da tabela de cores
+    r->corb = (corb != NULL) ? internaCor(corb) : COR_INDEFINIDA;
+    r->corp = (corp != NULL) ? internaCor(corp) : COR_INDEFINIDA;
 
     r->sw = 1.0;  //largura da borda, altera no setsw   
     r->disp = disp; 
@@ -72,9 +59,7 @@ void destroiRetangulo(Retangulo r) {
         return;
     }
     retanguloR *ret = (retanguloR*) r;
-    free(ret->corb);
-    free(ret->corp);
-    free(ret);
+    liberaMemoriaForma(ret);
 }
 
 //get =   retanguloR *ret = (retanguloR*) r, pega o tipo opaco e faz o cast pra struct, convertendo o Retangulo pra retanguloR* e dps retorna campo desejado(ex: x,y, w...)
@@ -101,10 +86,20 @@ double getAlturaRetangulo(Retangulo r) {
 
 char* getCorbRetangulo(Retangulo r) {
     retanguloR *ret = (retanguloR*) r;
-    return ret->corb;
+    return (char*) getNomeCor(ret->corb);
 }
 
 char* getCorpRetangulo(Retangulo r) {
+    retanguloR *ret = (retanguloR*) r;
+    return (char*) getNomeCor(ret->corp);
+}
+
+IdCor getIdCorbRetangulo(Retangulo r) {
+    retanguloR *ret = (retanguloR*) r;
+    return ret->corb;
+}
+
+IdCor getIdCorpRetangulo(Retangulo r) {
     retanguloR *ret = (retanguloR*) r;
     return ret->corp;
 }
@@ -154,28 +149,25 @@ void setAlturaRetangulo(Retangulo r, double h) {
     ret->h = h;
 }
 
-//mais complexos - alocar dinamicamente
+//cores: cadastra o nome na tabela de cores e guarda so o id
 void setCorbRetangulo(Retangulo r, const char* corb) {
     retanguloR *ret = (retanguloR*) r;
-    free(ret->corb);
-    ret->corb = (char*) malloc((strlen(corb) + 1) * sizeof(char));
-    if (ret->corb == NULL) {
-        printf("\n Erro na alocacao de memoria!!\n");
-        exit(1);
-    }
-    strcpy(ret->corb, corb);
+    ret->corb = internaCor(corb);
 }
 
 void setCorpRetangulo(Retangulo r,const char* corp) {
     retanguloR *ret = (retanguloR*) r;
-    free(ret->corp);
-    ret->corp = (char*) malloc((strlen(corp) + 1) * sizeof(char));
-    if (ret->corp == NULL) {
-        printf("\n Erro na alocacao de memoria!!\n");
-        exit(1);
-    }
+    ret->corp = internaCor(corp);
+}
+
+void setIdCorbRetangulo(Retangulo r, IdCor corb) {
+    retanguloR *ret = (retanguloR*) r;
+    ret->corb = corb;
+}
 
-    strcpy(ret->corp, corp);
+void setIdCorpRetangulo(Retangulo r, IdCor corp) {
+    retanguloR *ret = (retanguloR*) r;
+    ret->corp = corp;
 }
 
 void setSWRetangulo(Retangulo r, double sw) {
@@ -232,18 +224,25 @@ bool retangulosIntersectam(Retangulo r1, Retangulo r2) {
 
 //renderizacao
 
-void imprimeRetanguloSVG(Retangulo r, FILE *arquivo) {
-    if (r == NULL || arquivo == NULL) {
+void imprimeRetanguloSVG(Retangulo r, EscritorSvg svg) {
+    if (r == NULL || svg == NULL) {
         return;
     }
 
     retanguloR *ret = (retanguloR*) r;
-fprintf(arquivo, "\t<rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\" fill=\"%s\" fill-opacity=\"0.5\" stroke=\"%s\" stroke-width=\"%.2f\" />\n",
-        ret->x,
-        ret->y,
-        ret->w,
-        ret->h,
-        ret->corp,  
-        ret->corb,  
-        ret->sw);
+    escreveStrSvg(svg, "\t<rect x=\"");
+    escreveDecimalSvg(svg, ret->x);
+    escreveStrSvg(svg, "\" y=\"");
+    escreveDecimalSvg(svg, ret->y);
+    escreveStrSvg(svg, "\" width=\"");
+    escreveDecimalSvg(svg, ret->w);
+    escreveStrSvg(svg, "\" height=\"");
+    escreveDecimalSvg(svg, ret->h);
+    escreveStrSvg(svg, "\" fill=\"");
+    escreveStrSvg(svg, getNomeCor(ret->corp));
+    escreveStrSvg(svg, "\" fill-opacity=\"0.5\" stroke=\"");
+    escreveStrSvg(svg, getNomeCor(ret->corb));
+    escreveStrSvg(svg, "\" stroke-width=\"");
+    escreveDecimalSvg(svg, ret->sw);
+    escreveStrSvg(svg, "\" />\n");
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "cores.h"
+#include "escritorSvg.h"
+
 /*
 *        TIPO ABSTRATO DE DADOS: RETANGULO
 *
@@ -37,6 +40,7 @@ agrupamento ou filtragem de retângulos.
 *        h : altura do retângulo em unidades de medida (deve ser > 0)
 *        corb: string representando a cor da borda/contorno do retângulo
 *        corp: string representando a cor de preenchimento interno do retângulo
+*              (corb/corp NULL: a cor fica COR_INDEFINIDA até setIdCorb/setIdCorpRetangulo)
 *        disp: flag booleana indicando se o retângulo foi disparado/ativado
 *        n : identificador numérico adicional para seleção ou agrupamento
 *
@@ -105,6 +109,10 @@ char* getCorbRetangulo(Retangulo r);
 //Retorna a cor de preenchimento do retângulo, definindo a aparência do interior do retângulo quando renderizado.
 char* getCorpRetangulo(Retangulo r);
 
+//Retornam os identificadores (tabela de cores) da cor da borda e da cor de preenchimento.
+IdCor getIdCorbRetangulo(Retangulo r);
+IdCor getIdCorpRetangulo(Retangulo r);
+
 /*
 Retorna a largura do traço da borda (stroke-width), ou seja a espessura da linha
 que forma o contorno do retângulo. Quanto maior o valor, mais grossa a borda, e sempre >=0.
@@ -176,6 +184,10 @@ void setCorbRetangulo(Retangulo r,const char* corb);
 //Define a cor de preenchimento interno, modificando a aparência do interior do retângulo.
 void setCorpRetangulo(Retangulo r,const char* corp);
 
+//Definem as cores a partir de identificadores já cadastrados na tabela de cores, sem consultar nomes.
+void setIdCorbRetangulo(Retangulo r, IdCor corb);
+void setIdCorpRetangulo(Retangulo r, IdCor corp);
+
 /*
 Define a largura do traço da borda (pré-requisito: sw >= 0).
 Esta operação controla a espessura da linha que forma o contorno,
@@ -243,11 +255,11 @@ com as cores, âncora e estilo tipográfico definidos. A âncora é convertida
 automaticamente para o formato SVG ('i'→"start", 'm'→"middle", 'f'→"end").
 
 *        r: ponteiro opaco para o retangulo a ser renderizado
-*        arquivo: ponteiro para FILE aberto para escrita em modo SVG
+*        svg: escritor SVG de destino (escritorSvg.h)
 *
 *        Pré-condição: r deve ser um ponteiro válido para Retangulo,
-*                      arquivo deve ser um FILE* válido aberto para escrita
+*                      svg deve ser um escritor válido
 */
-void imprimeRetanguloSVG(Retangulo r, FILE *arquivo);
+void imprimeRetanguloSVG(Retangulo r, EscritorSvg svg);
 
 #endif
\ No newline at end of file
@@ -1,63 +1,107 @@
 #include "texto.h"
+#include "memoriaFormas.h"
+#include "cores.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Estrutura interna do Estilo (sintaxe de typedef mais concisa)
-typedef struct stEstilo {
+// Dados de um estilo. São imutáveis e compartilhados: estilos com a mesma
+// família, peso e tamanho usam os mesmos dados (tabela de estilos abaixo),
+// com um contador de referências. As três strings ficam no mesmo bloco.
+typedef struct stDadosEstilo {
     char *fFamily;
     char *fWeight;
     char *fSize;
+    int referencias;
+} DadosEstilo;
+
+// Estrutura interna do Estilo: apenas uma referência para dados compartilhados.
+// Alterar um estilo (setFamily etc.) troca a referência, sem afetar quem
+// compartilhava os dados antigos (cópia na escrita).
+typedef struct stEstilo {
+    DadosEstilo *d;
 } Estilo_t;
 
 // Estrutura interna do Texto (sintaxe de typedef mais concisa)
 typedef struct stTexto {
     int i;
     double x, y;
-    char *corb, *corp;
+    IdCor corb, corp;  // ids da tabela de cores
     char a;  // âncora: 'i', 'm', 'f'
     char *txto;
-    Estilo_t *e;
+    Estilo_t e;  // referência embutida, não precisa de alocação própria
 } Texto_t;
 
 
-/*________________________________ FUNÇÕES AUXILIARES INTERNAS ________________________________*/
+/*________________________________ TABELA DE ESTILOS ________________________________*/
 
-// Cria uma cópia de um estilo existente
-// O estilo original é const, pois não será modificado.
-Estilo_t *criaCopiaEstilo(const Estilo_t *original) {
-    if (original == NULL) {
-        return NULL;
+// estilos distintos em uso (poucos: um por combinação de 'ts')
+static DadosEstilo **tabelaEstilos = NULL;
+static int numEstilos = 0;
+static int capacidadeEstilos = 0;
+
+// Retorna os dados compartilhados para os valores dados, criando-os se
+// ainda não existirem, e conta uma nova referência
+static DadosEstilo *obtemDadosEstilo(const char *family, const char *weight, const char *size) {
+    for (int k = 0; k < numEstilos; k++) {
+        DadosEstilo *d = tabelaEstilos[k];
+        if (strcmp(d->fFamily, family) == 0 && strcmp(d->fWeight, weight) == 0 &&
+            strcmp(d->fSize, size) == 0) {
+            d->referencias++;
+            return d;
+        }
     }
-    
-    Estilo_t *e = (Estilo_t *)malloc(sizeof(Estilo_t));
-    if (e == NULL) {
-        // Erros devem ir para stderr
+
+    size_t lenF = strlen(family) + 1;
+    size_t lenW = strlen(weight) + 1;
+    size_t lenS = strlen(size) + 1;
+
+    DadosEstilo *d = (DadosEstilo *)malloc(sizeof(DadosEstilo) + lenF + lenW + lenS);
+    if (d == NULL) {
         fprintf(stderr, "Erro ao alocar memoria para o estilo do texto!\n");
         exit(1);
     }
-    
-    // Alocação e cópia dos campos da string
-    e->fFamily = (char *)malloc(strlen(original->fFamily) + 1);
-    strcpy(e->fFamily, original->fFamily);
-    
-    e->fWeight = (char *)malloc(strlen(original->fWeight) + 1);
-    strcpy(e->fWeight, original->fWeight);
-    
-    e->fSize = (char *)malloc(strlen(original->fSize) + 1);
-    strcpy(e->fSize, original->fSize);
-
-    // Validação de alocação para robustez
-    if (e->fFamily == NULL || e->fWeight == NULL || e->fSize == NULL) {
-        fprintf(stderr, "Erro ao alocar memoria para os campos do estilo!\n");
-        free(e->fFamily);
-        free(e->fWeight);
-        free(e->fSize);
-        free(e);
-        exit(1);
+    d->fFamily = (char *)(d + 1);
+    d->fWeight = d->fFamily + lenF;
+    d->fSize = d->fWeight + lenW;
+    memcpy(d->fFamily, family, lenF);
+    memcpy(d->fWeight, weight, lenW);
+    memcpy(d->fSize, size, lenS);
+    d->referencias = 1;
+
+    if (numEstilos == capacidadeEstilos) {
+        int novaCapacidade = (capacidadeEstilos == 0) ? 8 : capacidadeEstilos * 2;
+        DadosEstilo **nova = (DadosEstilo **)realloc(tabelaEstilos, novaCapacidade * sizeof(DadosEstilo *));
+        if (nova == NULL) {
+            fprintf(stderr, "Erro ao alocar memoria para a tabela de estilos!\n");
+            exit(1);
+        }
+        tabelaEstilos = nova;
+        capacidadeEstilos = novaCapacidade;
     }
-    
-    return e;
+    tabelaEstilos[numEstilos++] = d;
+
+    return d;
+}
+
+// Solta uma referência; os dados saem da tabela quando ninguém mais os usa
+static void soltaDadosEstilo(DadosEstilo *d) {
+    if (d == NULL) {
+        return;
+    }
+
+    d->referencias--;
+    if (d->referencias > 0) {
+        return;
+    }
+
+    for (int k = 0; k < numEstilos; k++) {
+        if (tabelaEstilos[k] == d) {
+            tabelaEstilos[k] = tabelaEstilos[--numEstilos];
+            break;
+        }
+    }
+    free(d);
 }
 
 
@@ -70,24 +114,7 @@ Estilo criarEstilo(const char *family, const char *weight, const char *size) {
         exit(1);
     }
     
-    e->fFamily = (char *)malloc(strlen(family) + 1);
-    strcpy(e->fFamily, family);
-    
-    e->fWeight = (char *)malloc(strlen(weight) + 1);
-    strcpy(e->fWeight, weight);
-    
-    e->fSize = (char *)malloc(strlen(size) + 1);
-    strcpy(e->fSize, size);
-
-    if (e->fFamily == NULL || e->fWeight == NULL || e->fSize == NULL) {
-        fprintf(stderr, "Erro ao alocar memoria para os campos do estilo!\n");
-        free(e->fFamily);
-        free(e->fWeight);
-        free(e->fSize);
-        free(e);
-        exit(1);
-    }
-    
+    e->d = obtemDadosEstilo(family, weight, size);
     return (Estilo)e;
 }
 
@@ -97,69 +124,63 @@ void destroiEstilo(Estilo e) {
     }
     
     Estilo_t *est = (Estilo_t *)e;
-    free(est->fFamily);
-    free(est->fWeight);
-    free(est->fSize);
+    soltaDadosEstilo(est->d);
     free(est);
 }
 
+void liberaTabelaEstilos() {
+    for (int k = 0; k < numEstilos; k++) {
+        free(tabelaEstilos[k]);
+    }
+    free(tabelaEstilos);
+    tabelaEstilos = NULL;
+    numEstilos = 0;
+    capacidadeEstilos = 0;
+}
+
 // Getters agora usam "const" para indicar que não modificam o objeto
 char* getFamily(const Estilo e) {
     if (e == NULL) return NULL;
-    return ((Estilo_t *)e)->fFamily;
+    return ((Estilo_t *)e)->d->fFamily;
 }
 
 char* getWeight(const Estilo e) {
     if (e == NULL) return NULL;
-    return ((Estilo_t *)e)->fWeight;
+    return ((Estilo_t *)e)->d->fWeight;
 }
 
 char* getSize(const Estilo e) {
     if (e == NULL) return NULL;
-    return ((Estilo_t *)e)->fSize;
+    return ((Estilo_t *)e)->d->fSize;
 }
 
-// Setters agora recebem "const char*" pois apenas leem a string de entrada
+// Setters: cópia na escrita, o estilo passa a apontar para os dados com o
+// novo valor e os dados antigos continuam valendo para quem os compartilha
 void setFamily(Estilo e, const char *family) {
     if (e == NULL || family == NULL) return;
     
     Estilo_t *est = (Estilo_t *)e;
-    
-    char *novaFamilia = (char *)realloc(est->fFamily, strlen(family) + 1);
-    if (novaFamilia == NULL) {
-        fprintf(stderr, "Erro ao realocar a familia do estilo do texto!\n");
-        return;
-    }
-    strcpy(novaFamilia, family);
-    est->fFamily = novaFamilia;
+    DadosEstilo *antigo = est->d;
+    est->d = obtemDadosEstilo(family, antigo->fWeight, antigo->fSize);
+    soltaDadosEstilo(antigo);
 }
 
 void setWeight(Estilo e, const char *weight) {
     if (e == NULL || weight == NULL) return;
     
     Estilo_t *est = (Estilo_t *)e;
-    
-    char *novoPeso = (char *)realloc(est->fWeight, strlen(weight) + 1);
-    if (novoPeso == NULL) {
-        fprintf(stderr, "Erro ao realocar a espessura do estilo do texto!\n");
-        return;
-    }
-    strcpy(novoPeso, weight);
-    est->fWeight = novoPeso;
+    DadosEstilo *antigo = est->d;
+    est->d = obtemDadosEstilo(antigo->fFamily, weight, antigo->fSize);
+    soltaDadosEstilo(antigo);
 }
 
 void setSize(Estilo e, const char *size) {
     if (e == NULL || size == NULL) return;
     
     Estilo_t *est = (Estilo_t *)e;
-    
-    char *novoSize = (char *)realloc(est->fSize, strlen(size) + 1);
-    if (novoSize == NULL) {
-        fprintf(stderr, "Erro ao realocar o tamanho do estilo do texto!\n");
-        return;
-    }
-    strcpy(novoSize, size);
-    est->fSize = novoSize;
+    DadosEstilo *antigo = est->d;
+    est->d = obtemDadosEstilo(antigo->fFamily, antigo->fWeight, size);
+    soltaDadosEstilo(antigo);
 }
 
 
@@ -167,7 +188,7 @@ void setSize(Estilo e, const char *size) {
 
 // Corrigido o nome do parâmetro "texto" para "conteudo" para evitar conflito
 Texto criarTexto(int i, double x, double y, const char *corb, const char *corp, char a, const char *conteudo, Estilo estilo) {
-    Texto_t *t = (Texto_t *)malloc(sizeof(Texto_t));
+    Texto_t *t = (Texto_t *)alocaMemoriaForma(sizeof(Texto_t));
     if (t == NULL) {
         fprintf(stderr, "Erro ao alocar memoria para a stTexto!\n");
         exit(1);
@@ -178,25 +199,23 @@ Texto criarTexto(int i, double x, double y, const char *corb, const char *corp,
     t->y = y;
     t->a = a;
     
-    t->corb = (char *)malloc(strlen(corb) + 1);
-    strcpy(t->corb, corb);
-    
-    t->corp = (char *)malloc(strlen(corp) + 1);
-    strcpy(t->corp, corp);
+    t->corb = (corb != NULL) ? internaCor(corb) : COR_INDEFINIDA;
+    t->corp = (corp != NULL) ? internaCor(corp) : COR_INDEFINIDA;
     
     t->txto = (char *)malloc(strlen(conteudo) + 1);
-    strcpy(t->txto, conteudo);
-    
-    if (t->corb == NULL || t->corp == NULL || t->txto == NULL) {
+    if (t->txto == NULL) {
         fprintf(stderr, "Erro ao alocar memoria para os campos do texto!\n");
-        free(t->corb);
-        free(t->corp);
-        free(t->txto);
-        free(t);
+        liberaMemoriaForma(t);
         exit(1);
     }
+    strcpy(t->txto, conteudo);
     
-    t->e = criaCopiaEstilo((Estilo_t *)estilo);
+    // compartilha os dados do estilo recebido (sem cópia)
+    t->e.d = NULL;
+    if (estilo != NULL) {
+        t->e.d = ((Estilo_t *)estilo)->d;
+        t->e.d->referencias++;
+    }
     
     return (Texto)t;
 }
@@ -204,13 +223,17 @@ Texto criarTexto(int i, double x, double y, const char *corb, const char *corp,
 void destroiTexto(Texto t) {
     if (t == NULL) return;
     
+    descartaTexto(t);
+    liberaMemoriaForma(t);
+}
+
+void descartaTexto(Texto t) {
+    if (t == NULL) return;
+
     Texto_t *txt = (Texto_t *)t;
-    
-    free(txt->corb);
-    free(txt->corp);
+
     free(txt->txto);
-    destroiEstilo(txt->e);
-    free(txt);
+    soltaDadosEstilo(txt->e.d);
 }
 
 int getIdTexto(const Texto t) {
@@ -230,11 +253,21 @@ double getYTexto(const Texto t) {
 
 char* getCorbTexto(const Texto t) {
     if (t == NULL) return NULL;
-    return ((Texto_t *)t)->corb;
+    return (char *)getNomeCor(((Texto_t *)t)->corb);
 }
 
 char* getCorpTexto(const Texto t) {
     if (t == NULL) return NULL;
+    return (char *)getNomeCor(((Texto_t *)t)->corp);
+}
+
+IdCor getIdCorbTexto(const Texto t) {
+    if (t == NULL) return -1;
+    return ((Texto_t *)t)->corb;
+}
+
+IdCor getIdCorpTexto(const Texto t) {
+    if (t == NULL) return -1;
     return ((Texto_t *)t)->corp;
 }
 
@@ -250,7 +283,9 @@ char* getTexto(const Texto t) {
 
 Estilo getEstiloTexto(const Texto t) {
     if (t == NULL) return NULL;
-    return (Estilo)((Texto_t *)t)->e;
+    Texto_t *txt = (Texto_t *)t;
+    if (txt->e.d == NULL) return NULL;
+    return (Estilo)&txt->e;
 }
 
 //set
@@ -267,28 +302,22 @@ void setYTexto(Texto t, double y) {
 
 void setCorbTexto(Texto t, const char *corb) {
     if (t == NULL || corb == NULL) return;
-    
-    Texto_t *txt = (Texto_t *)t;
-    char *novaCorb = (char *)realloc(txt->corb, strlen(corb) + 1);
-    if (novaCorb == NULL) {
-        fprintf(stderr, "Erro ao realocar memoria para a nova cor de borda!\n");
-        return;
-    }
-    strcpy(novaCorb, corb);
-    txt->corb = novaCorb;
+    ((Texto_t *)t)->corb = internaCor(corb);
 }
 
 void setCorpTexto(Texto t, const char *corp) {
     if (t == NULL || corp == NULL) return;
+    ((Texto_t *)t)->corp = internaCor(corp);
+}
 
-    Texto_t *txt = (Texto_t *)t;
-    char *novaCorp = (char *)realloc(txt->corp, strlen(corp) + 1);
-     if (novaCorp == NULL) {
-        fprintf(stderr, "Erro ao realocar memoria para a nova cor de preenchimento!\n");
-        return;
-    }
-    strcpy(novaCorp, corp);
-    txt->corp = novaCorp;
+void setIdCorbTexto(Texto t, IdCor corb) {
+    if (t == NULL) return;
+    ((Texto_t *)t)->corb = corb;
+}
+
+void setIdCorpTexto(Texto t, IdCor corp) {
+    if (t == NULL) return;
+    ((Texto_t *)t)->corp = corp;
 }
 
 void setAncora(Texto t, char a) {
@@ -313,19 +342,21 @@ void setEstiloTexto(Texto t, Estilo estilo) {
     if (t == NULL || estilo == NULL) return;
     
     Texto_t *txt = (Texto_t *)t;
+    DadosEstilo *antigo = txt->e.d;
     
-    destroiEstilo(txt->e);
-    txt->e = criaCopiaEstilo((Estilo_t *)estilo);
+    txt->e.d = ((Estilo_t *)estilo)->d;
+    txt->e.d->referencias++;
+    soltaDadosEstilo(antigo);
 }
 
 
 /*________________________________ FUNÇÕES DE RENDERIZAÇÃO ________________________________*/
 
-void imprimeTextoSVG(const Texto t, FILE *arquivo) {
-    if (t == NULL || arquivo == NULL) return;
+void imprimeTextoSVG(const Texto t, EscritorSvg svg) {
+    if (t == NULL || svg == NULL) return;
     
     Texto_t *txt = (Texto_t *)t;
-    Estilo_t *est = txt->e;
+    DadosEstilo *est = txt->e.d;
     
     const char *text_anchor = "middle"; // Valor padrão
     if (txt->a == 'i') {
@@ -334,15 +365,31 @@ void imprimeTextoSVG(const Texto t, FILE *arquivo) {
         text_anchor = "end";
     }
     
-    fprintf(arquivo, "\t<text x=\"%.2f\" y=\"%.2f\" fill=\"%s\" stroke=\"%s\" text-anchor=\"%s\"",
-            txt->x, txt->y, txt->corp, txt->corb, text_anchor);
+    escreveStrSvg(svg, "\t<text x=\"");
+    escreveDecimalSvg(svg, txt->x);
+    escreveStrSvg(svg, "\" y=\"");
+    escreveDecimalSvg(svg, txt->y);
+    escreveStrSvg(svg, "\" fill=\"");
+    escreveStrSvg(svg, getNomeCor(txt->corp));
+    escreveStrSvg(svg, "\" stroke=\"");
+    escreveStrSvg(svg, getNomeCor(txt->corb));
+    escreveStrSvg(svg, "\" text-anchor=\"");
+    escreveStrSvg(svg, text_anchor);
+    escreveCharSvg(svg, '"');
     
     if (est != NULL) {
-        fprintf(arquivo, " font-family=\"%s\" font-weight=\"%s\" font-size=\"%s\"",
-                est->fFamily, est->fWeight, est->fSize);
+        escreveStrSvg(svg, " font-family=\"");
+        escreveStrSvg(svg, est->fFamily);
+        escreveStrSvg(svg, "\" font-weight=\"");
+        escreveStrSvg(svg, est->fWeight);
+        escreveStrSvg(svg, "\" font-size=\"");
+        escreveStrSvg(svg, est->fSize);
+        escreveCharSvg(svg, '"');
     }
     
-    fprintf(arquivo, ">%s</text>\n", txt->txto);
+    escreveCharSvg(svg, '>');
+    escreveStrSvg(svg, txt->txto);
+    escreveStrSvg(svg, "</text>\n");
 }
 
 //para debug
@@ -350,12 +397,12 @@ void imprimeTextoTXT(const Texto t, FILE *arquivo) {
     if (t == NULL || arquivo == NULL) return;
     
     Texto_t *txt = (Texto_t *)t;
-    Estilo_t *est = txt->e;
+    DadosEstilo *est = txt->e.d;
     
     fprintf(arquivo, "Texto ID: %d\n", txt->i);
     fprintf(arquivo, "  Posição: (%.2f, %.2f)\n", txt->x, txt->y);
-    fprintf(arquivo, "  Cor borda: %s\n", txt->corb);
-    fprintf(arquivo, "  Cor preenchimento: %s\n", txt->corp);
+    fprintf(arquivo, "  Cor borda: %s\n", getNomeCor(txt->corb));
+    fprintf(arquivo, "  Cor preenchimento: %s\n", getNomeCor(txt->corp));
     fprintf(arquivo, "  Âncora: %c\n", txt->a);
     fprintf(arquivo, "  Conteúdo: \"%s\"\n", txt->txto);
     
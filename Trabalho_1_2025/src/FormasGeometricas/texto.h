@@ -5,6 +5,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "cores.h"
+#include "escritorSvg.h"
+
 //ponteiro generico para o texto e estilo do texto, ambos serão explicados abaixo
 typedef void * Texto;
 typedef void * Estilo;
@@ -14,7 +17,9 @@ typedef void * Estilo;
 /*
 Cria e aloca memória para um novo objeto de Estilo. O estilo define
 a aparência tipográfica de um texto, incluindo a família da fonte,
-o peso (negrito, normal) e o tamanho.
+o peso (negrito, normal) e o tamanho. Estilos com os mesmos valores
+compartilham os mesmos dados internos (com contagem de referências),
+então criar vários estilos iguais não duplica as strings.
 
 * family: string que representa a família da fonte (ex: "Arial")
 * weight: string que representa o peso da fonte (ex: "bold")
@@ -34,9 +39,14 @@ Estilo criarEstilo(const char *family, const char *weight, const char *size);
 *   Pré-condição: e deve ser um ponteiro válido
 */
 
-//Libera toda a memória associada a um objeto de Estilo.
+//Libera o objeto de Estilo. Os dados compartilhados só são liberados
+//quando nenhum outro estilo ou texto os usa mais.
 void destroiEstilo(Estilo e);
 
+//Libera a tabela de estilos compartilhados. Chamar apenas no encerramento,
+//depois de destruir todos os estilos e textos.
+void liberaTabelaEstilos();
+
 /*
 Retorna a família da fonte associada a um estilo.
 *
@@ -66,6 +76,7 @@ Define uma nova família de fonte para um objeto de Estilo existente.
 * family: nova string da família da fonte
 *
 * Pós-condição: a família da fonte do estilo é atualizada
+* (apenas neste estilo: textos que o usaram antes não mudam)
 */
 void setFamily(Estilo e, const char *family);
 
@@ -75,6 +86,7 @@ Define um novo peso de fonte para um objeto de Estilo existente.
 * weight: nova string do peso da fonte
 *
 * Pós-condição: o peso da fonte do estilo é atualizado
+* (apenas neste estilo: textos que o usaram antes não mudam)
 */
 void setWeight(Estilo e, const char *weight);
 
@@ -84,6 +96,7 @@ Define um novo tamanho de fonte para um objeto de Estilo existente.
 * size: nova string do tamanho da fonte
 *
 * Pós-condição: o tamanho da fonte do estilo é atualizado
+* (apenas neste estilo: textos que o usaram antes não mudam)
 */
 void setSize(Estilo e, const char *size);
 
@@ -98,9 +111,12 @@ propriedades de posicionamento, cor, conteúdo textual e um estilo associado.
 * x, y: coordenadas do ponto de âncora do texto
 * corb: string da cor da borda do texto
 * corp: string da cor de preenchimento do texto
+*       (corb/corp NULL: a cor fica COR_INDEFINIDA até setIdCorb/setIdCorpTexto)
 * a: caractere da âncora ('i', 'm' ou 'f')
 * conteudo: a string de texto a ser exibida
-* estilo: um objeto de Estilo que define a aparência do texto
+* estilo: um objeto de Estilo que define a aparência do texto (o texto
+*         passa a compartilhar os dados do estilo; o chamador continua
+*         dono de 'estilo' e pode destruí-lo depois)
 *
 * Pré-condição: os parâmetros de ponteiro devem ser válidos
 * Pós-condição: retorna um ponteiro opaco para o Texto criado,
@@ -117,13 +133,22 @@ Texto criarTexto(int i, double x, double y, const char *corb, const char *corp,
 */
 
 /*
-Libera toda a memória associada a um objeto de Texto, incluindo a cópia
-interna do seu estilo.
+Libera toda a memória associada a um objeto de Texto, incluindo a
+referência ao seu estilo.
 *
 * Pós-condição: a memória alocada para o texto e suas propriedades é liberada
 */
 void destroiTexto(Texto t);
 
+/*
+Libera só o que o texto tem fora da sua célula (o conteúdo e a referência
+ao estilo), sem devolver a célula ao Pool. Usada no encerramento, quando
+liberaTodaMemoriaFormas libera todas as células de uma vez.
+*
+* Pós-condição: o texto não pode mais ser usado
+*/
+void descartaTexto(Texto t);
+
 
 /*                                              MÉTODOS GET (CONSULTA)                                                   */
 
@@ -173,6 +198,15 @@ Retorna a cor de preenchimento do texto.
 */
 char* getCorpTexto(const Texto t);
 
+/*
+Retornam os identificadores (tabela de cores) da cor da borda e da cor
+de preenchimento do texto.
+*
+* Pós-condição: retorna o IdCor, ou -1 se o texto for nulo
+*/
+IdCor getIdCorbTexto(const Texto t);
+IdCor getIdCorpTexto(const Texto t);
+
 /*
 Retorna o caractere de âncora do texto ('i', 'm' ou 'f').
 *
@@ -193,7 +227,8 @@ char* getTexto(const Texto t);
 Retorna o objeto de Estilo associado ao texto.
 *
 * Pós-condição: retorna um ponteiro opaco para o Estilo do texto,
-* ou NULL se o texto for nulo
+* ou NULL se o texto for nulo. O estilo pertence ao texto e não deve
+* ser passado para destroiEstilo
 */
 Estilo getEstiloTexto(const Texto t);
 
@@ -242,6 +277,15 @@ Define uma nova cor de preenchimento para o texto.
 */
 void setCorpTexto(Texto t, const char *corp);
 
+/*
+Definem as cores do texto a partir de identificadores já cadastrados na
+tabela de cores, sem consultar nomes.
+*
+* Pós-condição: a cor correspondente do texto é atualizada
+*/
+void setIdCorbTexto(Texto t, IdCor corb);
+void setIdCorpTexto(Texto t, IdCor corp);
+
 /*
 Define um novo caractere de âncora para o texto.
 
@@ -261,13 +305,13 @@ Define um novo conteúdo textual para o objeto.
 void setTexto(Texto t, const char *conteudo);
 
 /*
-Define um novo estilo para o texto. A função irá destruir o estilo antigo
-e criar uma nova cópia do estilo fornecido para garantir o encapsulamento.
+Define um novo estilo para o texto. O texto solta a referência ao estilo
+antigo e passa a compartilhar os dados do estilo fornecido.
 
 * estilo: o novo objeto de Estilo a ser aplicado
 *
 * Pré-condição: estilo deve ser um ponteiro válidos
-* Pós-condição: o estilo do texto é substituído por uma cópia do novo estilo
+* Pós-condição: o estilo do texto passa a ter os valores do novo estilo
 */
 void setEstiloTexto(Texto t, Estilo estilo);
 
@@ -280,16 +324,16 @@ o código SVG necessário para visualizar o texto na posição especificada,
 com as cores, âncora e estilo tipográfico definidos. A âncora é convertida
 automaticamente para o formato SVG ('i'→"start", 'm'→"middle", 'f'→"end").
 
-* arquivo: ponteiro para FILE aberto para escrita em modo SVG
+* svg: escritor SVG de destino (escritorSvg.h)
 *
-* arquivo deve ser um FILE* válido aberto para escrita
+* svg deve ser um escritor válido
 * Pós-condição: código SVG do texto é escrito no arquivo no formato:
 * <text x="..." y="..." fill="..." stroke="..." 
 * text-anchor="..." font-family="..." 
 * font-weight="..." font-size="...">conteudo</text>
-* se t ou arquivo forem NULL a função não faz nada
+* se t ou svg forem NULL a função não faz nada
 */
-void imprimeTextoSVG(const Texto t, FILE *arquivo);
+void imprimeTextoSVG(const Texto t, EscritorSvg svg);
 
 /*
 Imprime informações detalhadas do texto em formato texto simples.
@@ -0,0 +1,245 @@
+#include "contabilMemoria.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+// aqui dentro as chamadas vão direto para a libc
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+
+#define MODULO_EXCEDENTE (MAX_MODULOS_CONTABIL - 1)
+
+typedef struct {
+    const char *arquivo;
+    long alocacoes;
+    long liberacoes;
+    long bytesVivos;
+    long bytesPico;
+    long bytesTotal;
+} ModuloContabil;
+
+// cabeçalho antes de cada bloco; a união mantém o alinhamento do malloc
+typedef union {
+    struct {
+        size_t tam;
+        int modulo;
+    } info;
+    long double alinhamento;
+} CabecalhoContabil;
+
+static ModuloContabil modulos[MAX_MODULOS_CONTABIL];
+// o programa todo, com o pico real (a soma dos picos dos módulos não é)
+static ModuloContabil geral = { "TOTAL", 0, 0, 0, 0, 0 };
+static int numModulos = 0;
+static pthread_mutex_t travaModulos = PTHREAD_MUTEX_INITIALIZER;
+
+
+/*________________________________ FUNÇÕES AUXILIARES ________________________________*/
+
+static void escreveNaSaida() {
+    escreveContabilMemoria(stderr);
+}
+
+// nome do arquivo sem os diretórios
+static const char *nomeModulo(const char *arquivo) {
+    const char *barra = strrchr(arquivo, '/');
+    return barra != NULL ? barra + 1 : arquivo;
+}
+
+/*
+Índice do módulo do arquivo, guardado em *modulo (um por .c) para que a
+busca na tabela só aconteça na primeira alocação de cada arquivo.
+*/
+static int indiceModulo(const char *arquivo, int *modulo) {
+    int indice = __atomic_load_n(modulo, __ATOMIC_ACQUIRE);
+    if (indice >= 0) {
+        return indice;
+    }
+
+    pthread_mutex_lock(&travaModulos);
+    indice = -1;
+    for (int i = 0; i < numModulos; i++) {
+        if (strcmp(modulos[i].arquivo, nomeModulo(arquivo)) == 0) {
+            indice = i;
+            break;
+        }
+    }
+    if (indice < 0) {
+        if (numModulos == 0) {
+            atexit(escreveNaSaida);
+        }
+        if (numModulos < MODULO_EXCEDENTE) {
+            indice = numModulos++;
+            modulos[indice].arquivo = nomeModulo(arquivo);
+        } else {
+            indice = MODULO_EXCEDENTE;
+            modulos[indice].arquivo = "(outros)";
+        }
+    }
+    pthread_mutex_unlock(&travaModulos);
+
+    __atomic_store_n(modulo, indice, __ATOMIC_RELEASE);
+    return indice;
+}
+
+static void somaAlocacao(ModuloContabil *m, size_t tam) {
+    __atomic_fetch_add(&m->alocacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&m->bytesTotal, (long) tam, __ATOMIC_RELAXED);
+    long vivos = __atomic_add_fetch(&m->bytesVivos, (long) tam, __ATOMIC_RELAXED);
+
+    long pico = __atomic_load_n(&m->bytesPico, __ATOMIC_RELAXED);
+    while (vivos > pico &&
+           !__atomic_compare_exchange_n(&m->bytesPico, &pico, vivos, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void somaLiberacao(ModuloContabil *m, size_t tam) {
+    __atomic_fetch_add(&m->liberacoes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&m->bytesVivos, (long) tam, __ATOMIC_RELAXED);
+}
+
+static void contaAlocacao(int modulo, size_t tam) {
+    somaAlocacao(&modulos[modulo], tam);
+    somaAlocacao(&geral, tam);
+}
+
+static void contaLiberacao(int modulo, size_t tam) {
+    somaLiberacao(&modulos[modulo], tam);
+    somaLiberacao(&geral, tam);
+}
+
+static ModuloContabil leModulo(ModuloContabil *m) {
+    ModuloContabil copia;
+    copia.arquivo = m->arquivo;
+    copia.alocacoes = __atomic_load_n(&m->alocacoes, __ATOMIC_RELAXED);
+    copia.liberacoes = __atomic_load_n(&m->liberacoes, __ATOMIC_RELAXED);
+    copia.bytesVivos = __atomic_load_n(&m->bytesVivos, __ATOMIC_RELAXED);
+    copia.bytesPico = __atomic_load_n(&m->bytesPico, __ATOMIC_RELAXED);
+    copia.bytesTotal = __atomic_load_n(&m->bytesTotal, __ATOMIC_RELAXED);
+    return copia;
+}
+
+static void escreveLinha(FILE *arquivo, const ModuloContabil *m) {
+    fprintf(arquivo, "%-22s %12ld %12ld %14ld %14ld %16ld\n", m->arquivo,
+            m->alocacoes, m->liberacoes, m->bytesVivos, m->bytesPico, m->bytesTotal);
+}
+
+static void *marcaBloco(CabecalhoContabil *cab, size_t tam, int modulo) {
+    cab->info.tam = tam;
+    cab->info.modulo = modulo;
+    contaAlocacao(modulo, tam);
+    return cab + 1;
+}
+
+static int comparaPico(const void *a, const void *b) {
+    const ModuloContabil *ma = (const ModuloContabil*) a;
+    const ModuloContabil *mb = (const ModuloContabil*) b;
+    if (ma->bytesPico != mb->bytesPico) {
+        return ma->bytesPico > mb->bytesPico ? -1 : 1;
+    }
+    return strcmp(ma->arquivo, mb->arquivo);
+}
+
+
+/*________________________________ FUNÇÕES DE ALOCAÇÃO ________________________________*/
+
+void *alocaContabil(size_t tam, const char *arquivo, int *modulo) {
+    if (tam > (size_t) -1 - sizeof(CabecalhoContabil)) {
+        return NULL;
+    }
+    CabecalhoContabil *cab = (CabecalhoContabil*) malloc(sizeof(CabecalhoContabil) + tam);
+    if (cab == NULL) {
+        return NULL;
+    }
+    return marcaBloco(cab, tam, indiceModulo(arquivo, modulo));
+}
+
+void *alocaZeradoContabil(size_t n, size_t tam, const char *arquivo, int *modulo) {
+    if (tam != 0 && n > ((size_t) -1 - sizeof(CabecalhoContabil)) / tam) {
+        return NULL;
+    }
+    void *p = alocaContabil(n * tam, arquivo, modulo);
+    if (p != NULL) {
+        memset(p, 0, n * tam);
+    }
+    return p;
+}
+
+void *realocaContabil(void *p, size_t tam, const char *arquivo, int *modulo) {
+    if (p == NULL) {
+        return alocaContabil(tam, arquivo, modulo);
+    }
+    if (tam > (size_t) -1 - sizeof(CabecalhoContabil)) {
+        return NULL;
+    }
+
+    CabecalhoContabil *antigo = (CabecalhoContabil*) p - 1;
+    size_t tamAntigo = antigo->info.tam;
+    int moduloAntigo = antigo->info.modulo;
+
+    CabecalhoContabil *cab = (CabecalhoContabil*) realloc(antigo, sizeof(CabecalhoContabil) + tam);
+    if (cab == NULL) {
+        return NULL;
+    }
+    // o bloco passa para o módulo que o realocou
+    contaLiberacao(moduloAntigo, tamAntigo);
+    return marcaBloco(cab, tam, indiceModulo(arquivo, modulo));
+}
+
+void liberaContabil(void *p) {
+    if (p == NULL) {
+        return;
+    }
+    CabecalhoContabil *cab = (CabecalhoContabil*) p - 1;
+    contaLiberacao(cab->info.modulo, cab->info.tam);
+    free(cab);
+}
+
+
+/*________________________________ FUNÇÕES DE REPASSE ________________________________*/
+
+int moduloContabil(const char *arquivo, int *modulo) {
+    return indiceModulo(arquivo, modulo);
+}
+
+void repassaContabil(int dono, int usuario, size_t tam) {
+    __atomic_fetch_sub(&modulos[dono].bytesVivos, (long) tam, __ATOMIC_RELAXED);
+    somaAlocacao(&modulos[usuario], tam);
+}
+
+void devolveContabil(int dono, int usuario, size_t tam) {
+    somaLiberacao(&modulos[usuario], tam);
+    __atomic_fetch_add(&modulos[dono].bytesVivos, (long) tam, __ATOMIC_RELAXED);
+}
+
+
+/*________________________________ SAÍDA ________________________________*/
+
+void escreveContabilMemoria(FILE *arquivo) {
+    ModuloContabil copia[MAX_MODULOS_CONTABIL];
+    int n = 0;
+    pthread_mutex_lock(&travaModulos);
+    for (int i = 0; i < MAX_MODULOS_CONTABIL; i++) {
+        if (modulos[i].arquivo != NULL) {
+            copia[n++] = leModulo(&modulos[i]);
+        }
+    }
+    pthread_mutex_unlock(&travaModulos);
+
+    qsort(copia, (size_t) n, sizeof(ModuloContabil), comparaPico);
+
+    fprintf(arquivo, "===== MEMÓRIA POR MÓDULO (bytes pedidos) =====\n");
+    fprintf(arquivo, "%-22s %12s %12s %14s %14s %16s\n",
+            "modulo", "alocacoes", "liberacoes", "bytes_vivos", "bytes_pico", "bytes_total");
+    for (int i = 0; i < n; i++) {
+        escreveLinha(arquivo, &copia[i]);
+    }
+    ModuloContabil total = leModulo(&geral);
+    escreveLinha(arquivo, &total);
+}
@@ -0,0 +1,68 @@
+#ifndef CONTABILMEMORIA_H
+#define CONTABILMEMORIA_H
+
+/*
+*        MÓDULO: CONTABILIDADE DE MEMÓRIA POR MÓDULO
+*
+*        Camada opcional, ligada em tempo de compilação, que etiqueta cada
+*        malloc/calloc/realloc/free com o arquivo .c que o chamou (formas.c,
+*        circulo.c, fila.c, pilha.c, arena.c...). Por módulo são contadas as
+*        chamadas de alocação e de liberação, os bytes vivos, o pico de bytes
+*        vivos e o total de bytes pedidos; a tabela é escrita em stderr na
+*        saída do programa.
+*
+*        Para ligar:  make clean && make MEMORIA=1
+*
+*        O makefile então compila todo .c com "-include contabilMemoria.h",
+*        e as macros abaixo trocam as chamadas da libc pelas versões
+*        contabilizadas. Cada bloco ganha um cabeçalho de 16 bytes com o
+*        tamanho pedido e o módulo dono, para que free e realloc descontem
+*        do módulo certo (os bytes da tabela são os pedidos, sem o
+*        cabeçalho). Por isso toda memória liberada com free precisa ter
+*        sido alocada por código compilado com a mesma opção.
+*
+*        Sem MEMORIA=1 nada muda: este cabeçalho não é incluído em lugar
+*        nenhum e as funções abaixo ficam sem uso.
+*/
+
+// os cabeçalhos da libc vêm antes das macros, senão os protótipos seriam trocados
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void *alocaContabil(size_t tam, const char *arquivo, int *modulo);
+void *alocaZeradoContabil(size_t n, size_t tam, const char *arquivo, int *modulo);
+void *realocaContabil(void *p, size_t tam, const char *arquivo, int *modulo);
+void liberaContabil(void *p);
+
+// módulos distintos acompanhados; os excedentes somam na última linha
+#define MAX_MODULOS_CONTABIL 64
+
+/*
+Repasse entre módulos, para memória reservada em lote por um módulo (o
+dono, como pool.c) e usada aos pedaços por outros (circulo.c, texto.c...).
+O pedaço sai dos bytes vivos do dono e entra no usuário como uma alocação
+(repassaContabil) ou liberação (devolveContabil); o TOTAL não muda, pois o
+bloco do dono já foi contado uma vez.
+
+* moduloContabil: índice do módulo do arquivo (o mesmo que as macros usam)
+*/
+int moduloContabil(const char *arquivo, int *modulo);
+void repassaContabil(int dono, int usuario, size_t tam);
+void devolveContabil(int dono, int usuario, size_t tam);
+
+// Escreve a tabela por módulo no arquivo (já é chamada em stderr na saída do programa)
+void escreveContabilMemoria(FILE *arquivo);
+
+// índice do módulo deste .c na tabela, descoberto na primeira alocação
+static int contabilModuloLocal __attribute__((unused)) = -1;
+
+#define malloc(tam) alocaContabil((tam), __FILE__, &contabilModuloLocal)
+#define calloc(n, tam) alocaZeradoContabil((n), (tam), __FILE__, &contabilModuloLocal)
+#define realloc(p, tam) realocaContabil((p), (tam), __FILE__, &contabilModuloLocal)
+#define free(p) liberaContabil(p)
+
+#endif
@@ -0,0 +1,38 @@
+#include "contadorAlocacoes.h"
+
+#include <stddef.h>
+
+static long numAlocacoes = 0;
+
+// com --wrap estes nomes apontam para as funções da libc; sem --wrap ficam
+// nulos (fracos), mas aí os invólucros abaixo também nunca são chamados
+extern void *__real_malloc(size_t tam) __attribute__((weak));
+extern void *__real_calloc(size_t n, size_t tam) __attribute__((weak));
+extern void *__real_realloc(void *p, size_t tam) __attribute__((weak));
+
+void *__wrap_malloc(size_t tam);
+void *__wrap_calloc(size_t n, size_t tam);
+void *__wrap_realloc(void *p, size_t tam);
+
+void *__wrap_malloc(size_t tam) {
+    __atomic_fetch_add(&numAlocacoes, 1, __ATOMIC_RELAXED);
+    return __real_malloc(tam);
+}
+
+void *__wrap_calloc(size_t n, size_t tam) {
+    __atomic_fetch_add(&numAlocacoes, 1, __ATOMIC_RELAXED);
+    return __real_calloc(n, tam);
+}
+
+void *__wrap_realloc(void *p, size_t tam) {
+    __atomic_fetch_add(&numAlocacoes, 1, __ATOMIC_RELAXED);
+    return __real_realloc(p, tam);
+}
+
+long getNumAlocacoes() {
+    return __atomic_load_n(&numAlocacoes, __ATOMIC_RELAXED);
+}
+
+bool contagemAlocacoesAtiva() {
+    return __real_malloc != NULL;
+}
@@ -0,0 +1,25 @@
+#ifndef CONTADORALOCACOES_H
+#define CONTADORALOCACOES_H
+
+#include <stdbool.h>
+
+/*
+*        MÓDULO: CONTADOR DE ALOCAÇÕES
+*
+*        Conta as chamadas a malloc, calloc e realloc feitas pelo programa.
+*        O makefile liga o bench sempre, e o ted só com 'make PERFIL=1',
+*        com -Wl,--wrap=malloc (e calloc e realloc), então essas chamadas
+*        passam pelos invólucros deste módulo antes de chegar na libc. A
+*        contagem é um único inteiro atômico, somado sem trava.
+*
+*        Em um binário ligado sem --wrap os invólucros nunca são chamados:
+*        o programa funciona igual e contagemAlocacoesAtiva() retorna false.
+*/
+
+// Retorna quantas alocações foram feitas desde o início do programa
+long getNumAlocacoes();
+
+// Retorna true se o binário foi ligado com os invólucros (--wrap)
+bool contagemAlocacoesAtiva();
+
+#endif
@@ -0,0 +1,101 @@
+#include "escritorSvg.h"
+#include "formataNumero.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// tamanho do buffer de saída (1 MiB)
+#define TAMANHO_BUFFER_SVG (1 << 20)
+
+typedef struct {
+    FILE *arquivo;
+    size_t usado;
+    char buffer[TAMANHO_BUFFER_SVG];
+} EscritorSvgC;
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+EscritorSvg criaEscritorSvg(FILE *arquivo) {
+    EscritorSvgC *e = (EscritorSvgC*) malloc(sizeof(EscritorSvgC));
+    if (e == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    e->arquivo = arquivo;
+    e->usado = 0;
+    return (EscritorSvg) e;
+}
+
+void descarregaEscritorSvg(EscritorSvg e) {
+    EscritorSvgC *esc = (EscritorSvgC*) e;
+    if (esc->usado > 0 && esc->arquivo != NULL) {
+        fwrite(esc->buffer, 1, esc->usado, esc->arquivo);
+    }
+    esc->usado = 0;
+}
+
+void destroiEscritorSvg(EscritorSvg e) {
+    if (e == NULL) {
+        return;
+    }
+    descarregaEscritorSvg(e);
+    free(e);
+}
+
+FILE *getArquivoEscritorSvg(EscritorSvg e) {
+    if (e == NULL) {
+        return NULL;
+    }
+    return ((EscritorSvgC*) e)->arquivo;
+}
+
+
+/*________________________________ FUNÇÕES DE ESCRITA ________________________________*/
+
+// garante 'tamanho' bytes livres no buffer (tamanho <= TAMANHO_BUFFER_SVG)
+static char *reservaSvg(EscritorSvgC *esc, size_t tamanho) {
+    if (TAMANHO_BUFFER_SVG - esc->usado < tamanho) {
+        descarregaEscritorSvg(esc);
+    }
+    return esc->buffer + esc->usado;
+}
+
+void escreveBytesSvg(EscritorSvg e, const char *dados, size_t tamanho) {
+    EscritorSvgC *esc = (EscritorSvgC*) e;
+
+    if (tamanho >= TAMANHO_BUFFER_SVG) {
+        // maior que o buffer inteiro: vai direto para o arquivo
+        descarregaEscritorSvg(esc);
+        if (esc->arquivo != NULL) {
+            fwrite(dados, 1, tamanho, esc->arquivo);
+        }
+        return;
+    }
+
+    memcpy(reservaSvg(esc, tamanho), dados, tamanho);
+    esc->usado += tamanho;
+}
+
+void escreveStrSvg(EscritorSvg e, const char *s) {
+    escreveBytesSvg(e, s, strlen(s));
+}
+
+void escreveCharSvg(EscritorSvg e, char c) {
+    EscritorSvgC *esc = (EscritorSvgC*) e;
+    *reservaSvg(esc, 1) = c;
+    esc->usado++;
+}
+
+void escreveDecimalSvg(EscritorSvg e, double valor) {
+    EscritorSvgC *esc = (EscritorSvgC*) e;
+    char *destino = reservaSvg(esc, TAMANHO_MAX_DECIMAL);
+    esc->usado += (size_t) formataDecimal2(destino, valor);
+}
+
+void escreveInteiroSvg(EscritorSvg e, long valor) {
+    EscritorSvgC *esc = (EscritorSvgC*) e;
+    char *destino = reservaSvg(esc, TAMANHO_MAX_INTEIRO);
+    esc->usado += (size_t) formataInteiro(destino, valor);
+}
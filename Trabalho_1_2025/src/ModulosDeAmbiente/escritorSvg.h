@@ -0,0 +1,67 @@
+#ifndef ESCRITORSVG_H
+#define ESCRITORSVG_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/*
+*        TIPO ABSTRATO DE DADOS: ESCRITOR SVG
+*
+*        Saída bufferizada usada por toda a renderização SVG. O texto é
+*        acumulado em um buffer grande e só vai para o arquivo quando o
+*        buffer enche ou o escritor é destruído.
+*
+*        Os números são formatados pelas rotinas de formataNumero.h, com
+*        os mesmos bytes de "%.2f" e "%ld" do printf.
+*/
+
+typedef void *EscritorSvg;
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+/*
+Cria um escritor que grava no arquivo indicado.
+
+* arquivo: FILE* aberto para escrita
+*
+* Pré-condição: arquivo deve ser válido
+* Pós-condição: retorna o escritor, ou o programa é encerrado em caso de
+* falha de alocação. O escritor não fecha o arquivo.
+*/
+EscritorSvg criaEscritorSvg(FILE *arquivo);
+
+/*
+Grava o que restou no buffer e libera o escritor (o arquivo continua aberto).
+*/
+void destroiEscritorSvg(EscritorSvg e);
+
+// Retorna o arquivo de destino do escritor
+FILE *getArquivoEscritorSvg(EscritorSvg e);
+
+// Grava no arquivo todo o conteúdo acumulado no buffer
+void descarregaEscritorSvg(EscritorSvg e);
+
+
+/*________________________________ FUNÇÕES DE ESCRITA ________________________________*/
+/*
+* e: escritor de destino
+* Pré-condição: e deve ser um escritor válido
+*/
+
+// Escreve 'tamanho' bytes de 'dados'
+void escreveBytesSvg(EscritorSvg e, const char *dados, size_t tamanho);
+
+// Escreve uma string terminada em '\0'
+void escreveStrSvg(EscritorSvg e, const char *s);
+
+// Escreve um único caractere
+void escreveCharSvg(EscritorSvg e, char c);
+
+// Escreve 'valor' exatamente como printf("%.2f", valor)
+void escreveDecimalSvg(EscritorSvg e, double valor);
+
+// Escreve 'valor' exatamente como printf("%ld", valor)
+void escreveInteiroSvg(EscritorSvg e, long valor);
+
+#endif
@@ -0,0 +1,279 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "estatisticasQry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+// faixas do histograma: 0..3 ns exatos, depois 4 faixas por potência de 2
+#define NUM_FAIXAS 252
+
+// texto guardado de cada linha lenta
+#define TAMANHO_LINHA_LENTA 128
+
+// tipos de comando medidos; o último junta os desconhecidos
+static const char *NOMES_COMANDOS[] = {
+    "pd", "lc", "atch", "shft", "dsp", "rjd", "calc", "sbp", "outros"
+};
+#define NUM_TIPOS_COMANDO ((int) (sizeof(NOMES_COMANDOS) / sizeof(NOMES_COMANDOS[0])))
+
+typedef struct {
+    long quantidade;
+    uint64_t totalNs;
+    uint64_t maximoNs;
+    long faixas[NUM_FAIXAS];
+} EstatisticaComando;
+
+typedef struct {
+    uint64_t duracaoNs;
+    int numLinha;
+    char linha[TAMANHO_LINHA_LENTA];
+} LinhaLenta;
+
+typedef struct {
+    uint64_t inicioNs;
+    EstatisticaComando comandos[NUM_TIPOS_COMANDO];
+
+    // as linhas mais lentas, em um heap de mínimo por duração: a raiz é a
+    // mais rápida delas, a primeira a sair quando chega uma mais lenta
+    LinhaLenta *lentas;
+    int capacidadeLentas;
+    int numLentas;
+} EstatisticasQryC;
+
+
+/*________________________________ FUNÇÕES AUXILIARES ________________________________*/
+
+static uint64_t agoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static int faixaDe(uint64_t ns) {
+    if (ns < 4) {
+        return (int) ns;
+    }
+    int expoente = 63 - __builtin_clzll(ns);
+    int sub = (int) ((ns >> (expoente - 2)) & 3);
+    return 4 * (expoente - 1) + sub;
+}
+
+// menor valor que cai na faixa f
+static uint64_t inicioFaixa(int f) {
+    if (f < 4) {
+        return (uint64_t) f;
+    }
+    int expoente = f / 4 + 1;
+    return (uint64_t) (4 + f % 4) << (expoente - 2);
+}
+
+// maior valor que cai na faixa f
+static uint64_t fimFaixa(int f) {
+    if (f < 4) {
+        return (uint64_t) f;
+    }
+    return inicioFaixa(f) + ((uint64_t) 1 << (f / 4 - 1)) - 1;
+}
+
+static int indiceComando(const char *comando) {
+    for (int i = 0; i < NUM_TIPOS_COMANDO - 1; i++) {
+        if (strcmp(comando, NOMES_COMANDOS[i]) == 0) {
+            return i;
+        }
+    }
+    return NUM_TIPOS_COMANDO - 1;
+}
+
+/*
+Percentil q (0 < q <= 1) pelo histograma: o fim da faixa em que cai a
+observação de posição ceil(q * quantidade), limitado ao máximo observado.
+*/
+static uint64_t percentil(const EstatisticaComando *c, double q) {
+    long alvo = (long) (q * c->quantidade);
+    if (alvo < q * c->quantidade) alvo++;
+    if (alvo < 1) alvo = 1;
+
+    long acumulado = 0;
+    for (int f = 0; f < NUM_FAIXAS; f++) {
+        acumulado += c->faixas[f];
+        if (acumulado >= alvo) {
+            uint64_t fim = fimFaixa(f);
+            return fim < c->maximoNs ? fim : c->maximoNs;
+        }
+    }
+    return c->maximoNs;
+}
+
+static void trocaLentas(LinhaLenta *a, LinhaLenta *b) {
+    LinhaLenta aux = *a;
+    *a = *b;
+    *b = aux;
+}
+
+static void sobeLenta(LinhaLenta *heap, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (heap[pai].duracaoNs <= heap[i].duracaoNs) {
+            return;
+        }
+        trocaLentas(&heap[pai], &heap[i]);
+        i = pai;
+    }
+}
+
+static void desceLenta(LinhaLenta *heap, int n, int i) {
+    for (;;) {
+        int menor = i;
+        int esq = 2 * i + 1;
+        int dir = esq + 1;
+        if (esq < n && heap[esq].duracaoNs < heap[menor].duracaoNs) menor = esq;
+        if (dir < n && heap[dir].duracaoNs < heap[menor].duracaoNs) menor = dir;
+        if (menor == i) {
+            return;
+        }
+        trocaLentas(&heap[menor], &heap[i]);
+        i = menor;
+    }
+}
+
+static void preencheLinhaLenta(LinhaLenta *destino, uint64_t duracaoNs, int numLinha, const char *linha) {
+    destino->duracaoNs = duracaoNs;
+    destino->numLinha = numLinha;
+    size_t tam = strcspn(linha, "\r\n");
+    if (tam >= TAMANHO_LINHA_LENTA) {
+        tam = TAMANHO_LINHA_LENTA - 1;
+    }
+    memcpy(destino->linha, linha, tam);
+    destino->linha[tam] = '\0';
+}
+
+// O(log N) por comando: entra no fim e sobe enquanto encher; depois só
+// substitui a raiz (a mais rápida) e desce
+static void guardaLinhaLenta(EstatisticasQryC *e, uint64_t duracaoNs, int numLinha, const char *linha) {
+    if (e->numLentas < e->capacidadeLentas) {
+        int i = e->numLentas++;
+        preencheLinhaLenta(&e->lentas[i], duracaoNs, numLinha, linha);
+        sobeLenta(e->lentas, i);
+    } else if (duracaoNs > e->lentas[0].duracaoNs) {
+        preencheLinhaLenta(&e->lentas[0], duracaoNs, numLinha, linha);
+        desceLenta(e->lentas, e->numLentas, 0);
+    }
+}
+
+static int comparaLentas(const void *a, const void *b) {
+    const LinhaLenta *la = (const LinhaLenta*) a;
+    const LinhaLenta *lb = (const LinhaLenta*) b;
+    if (la->duracaoNs != lb->duracaoNs) {
+        return la->duracaoNs > lb->duracaoNs ? -1 : 1;
+    }
+    return la->numLinha - lb->numLinha;
+}
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+EstatisticasQry criaEstatisticasQry(int numLentas) {
+    EstatisticasQryC *e = (EstatisticasQryC*) calloc(1, sizeof(EstatisticasQryC));
+    if (e == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    if (numLentas > 0) {
+        e->lentas = (LinhaLenta*) malloc((size_t) numLentas * sizeof(LinhaLenta));
+        if (e->lentas == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+        e->capacidadeLentas = numLentas;
+    }
+    return (EstatisticasQry) e;
+}
+
+void destroiEstatisticasQry(EstatisticasQry e) {
+    if (e == NULL) {
+        return;
+    }
+    free(((EstatisticasQryC*) e)->lentas);
+    free(e);
+}
+
+
+/*________________________________ FUNÇÕES DE MEDIÇÃO ________________________________*/
+
+void iniciaComandoQry(EstatisticasQry e) {
+    ((EstatisticasQryC*) e)->inicioNs = agoraNs();
+}
+
+void encerraComandoQry(EstatisticasQry e, const char *comando, int numLinha, const char *linha) {
+    EstatisticasQryC *est = (EstatisticasQryC*) e;
+    uint64_t duracaoNs = agoraNs() - est->inicioNs;
+
+    EstatisticaComando *c = &est->comandos[indiceComando(comando)];
+    c->quantidade++;
+    c->totalNs += duracaoNs;
+    if (duracaoNs > c->maximoNs) {
+        c->maximoNs = duracaoNs;
+    }
+    c->faixas[faixaDe(duracaoNs)]++;
+
+    if (est->capacidadeLentas > 0) {
+        guardaLinhaLenta(est, duracaoNs, numLinha, linha);
+    }
+}
+
+
+/*________________________________ SAÍDA ________________________________*/
+
+void escreveEstatisticasQry(EstatisticasQry e, FILE *arquivo) {
+    EstatisticasQryC *est = (EstatisticasQryC*) e;
+
+    fprintf(arquivo, "===== ESTATÍSTICAS DOS COMANDOS =====\n");
+    fprintf(arquivo, "%-8s %10s %12s %12s %12s %12s %12s\n",
+            "comando", "qtd", "total_ms", "media_us", "p50_us", "p99_us", "max_us");
+    for (int i = 0; i < NUM_TIPOS_COMANDO; i++) {
+        const EstatisticaComando *c = &est->comandos[i];
+        if (c->quantidade == 0) {
+            continue;
+        }
+        fprintf(arquivo, "%-8s %10ld %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+                NOMES_COMANDOS[i], c->quantidade, c->totalNs / 1e6,
+                (double) c->totalNs / c->quantidade / 1e3,
+                percentil(c, 0.50) / 1e3, percentil(c, 0.99) / 1e3, c->maximoNs / 1e3);
+    }
+
+    fprintf(arquivo, "\n===== HISTOGRAMAS (faixa em us: quantidade) =====\n");
+    for (int i = 0; i < NUM_TIPOS_COMANDO; i++) {
+        const EstatisticaComando *c = &est->comandos[i];
+        if (c->quantidade == 0) {
+            continue;
+        }
+        fprintf(arquivo, "%s:\n", NOMES_COMANDOS[i]);
+        for (int f = 0; f < NUM_FAIXAS; f++) {
+            if (c->faixas[f] > 0) {
+                fprintf(arquivo, "  [%.3f, %.3f]: %ld\n",
+                        inicioFaixa(f) / 1e3, fimFaixa(f) / 1e3, c->faixas[f]);
+            }
+        }
+    }
+
+    if (est->numLentas > 0) {
+        LinhaLenta *ordenadas = (LinhaLenta*) malloc((size_t) est->numLentas * sizeof(LinhaLenta));
+        if (ordenadas == NULL) {
+            printf("Erro: falha na alocação de memória.\n");
+            exit(1);
+        }
+        memcpy(ordenadas, est->lentas, (size_t) est->numLentas * sizeof(LinhaLenta));
+        qsort(ordenadas, (size_t) est->numLentas, sizeof(LinhaLenta), comparaLentas);
+
+        fprintf(arquivo, "\n===== %d LINHAS MAIS LENTAS =====\n", est->numLentas);
+        for (int i = 0; i < est->numLentas; i++) {
+            fprintf(arquivo, "linha %d: %.3f us | %s\n",
+                    ordenadas[i].numLinha, ordenadas[i].duracaoNs / 1e3, ordenadas[i].linha);
+        }
+        free(ordenadas);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ESTATISTICASQRY_H
+#define ESTATISTICASQRY_H
+
+#include <stdio.h>
+
+/*
+*        TIPO ABSTRATO DE DADOS: ESTATÍSTICAS DOS COMANDOS DO .QRY
+*
+*        Mede quanto tempo cada comando do .qry leva. Para cada tipo de
+*        comando (pd, lc, atch, shft, dsp, rjd, calc, sbp e "outros") guarda
+*        a quantidade, o tempo total, o máximo e um histograma logarítmico
+*        (4 faixas por potência de 2 de nanossegundos), de onde saem p50 e
+*        p99 com erro de no máximo 25%. Guarda também as N linhas mais lentas
+*        do arquivo, com o número da linha.
+*
+*        Registrar um comando custa duas leituras do relógio e algumas
+*        somas, sem alocação.
+*/
+
+typedef void *EstatisticasQry;
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+/*
+Cria as estatísticas.
+
+* numLentas: quantas linhas mais lentas guardar (0 desliga)
+*
+* Pós-condição: retorna as estatísticas, ou o programa é encerrado em caso
+* de falha de alocação
+*/
+EstatisticasQry criaEstatisticasQry(int numLentas);
+
+// Libera as estatísticas
+void destroiEstatisticasQry(EstatisticasQry e);
+
+
+/*________________________________ FUNÇÕES DE MEDIÇÃO ________________________________*/
+
+// Marca o início de um comando
+void iniciaComandoQry(EstatisticasQry e);
+
+/*
+Registra o comando iniciado em iniciaComandoQry.
+
+* comando: nome do comando (primeira palavra da linha)
+* numLinha: número da linha no .qry (a partir de 1)
+* linha: texto da linha (copiado só se ela estiver entre as mais lentas)
+*/
+void encerraComandoQry(EstatisticasQry e, const char *comando, int numLinha, const char *linha);
+
+
+/*________________________________ SAÍDA ________________________________*/
+
+/*
+Escreve, em texto, a tabela por comando (quantidade, total, média, p50, p99
+e máximo), os histogramas e as linhas mais lentas.
+*/
+void escreveEstatisticasQry(EstatisticasQry e, FILE *arquivo);
+
+#endif
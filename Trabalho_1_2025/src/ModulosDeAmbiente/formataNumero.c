@@ -0,0 +1,94 @@
+#include "formataNumero.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+
+// a formatação rápida cobre |valor| < LIMITE_RAPIDO (centésimos abaixo de
+// 2^52, então k + 0.5 é exato em double); acima disso usa snprintf
+#define LIMITE_RAPIDO 1e13
+
+/*
+Retorna round(a * 100) com o arredondamento do printf: pelo valor exato de
+a*100 e, no empate exato, para o par. Requer 0 <= a < LIMITE_RAPIDO.
+*/
+static uint64_t centesimosArredondados(double a) {
+#if LDBL_MANT_DIG >= 64
+    // a tem 53 bits e 100 tem 7: o produto cabe exato nos 64 bits do long double
+    long double produto = (long double) a * 100.0L;
+    uint64_t k = (uint64_t) produto;
+    long double resto = produto - (long double) k;
+    if (resto > 0.5L || (resto == 0.5L && (k & 1))) {
+        k++;
+    }
+    return k;
+#else
+    // sem long double estendido: compara com k + 0.5 usando fma, que
+    // calcula a*100 - (k + 0.5) com um único arredondamento (sinal exato)
+    uint64_t k = (uint64_t) (a * 100.0);
+    while (k > 0 && fma(a, 100.0, -(double) k) < 0) k--;
+    while (fma(a, 100.0, -(double) (k + 1)) >= 0) k++;
+    double diferenca = fma(a, 100.0, -((double) k + 0.5));
+    if (diferenca > 0 || (diferenca == 0 && (k & 1))) {
+        k++;
+    }
+    return k;
+#endif
+}
+
+int formataDecimal2(char *destino, double valor) {
+    if (!(fabs(valor) < LIMITE_RAPIDO)) {
+        // inf, nan e valores enormes: formatação genérica
+        return snprintf(destino, TAMANHO_MAX_DECIMAL, "%.2f", valor);
+    }
+
+    char *p = destino;
+    if (signbit(valor)) {
+        *p++ = '-';
+    }
+
+    uint64_t centesimos = centesimosArredondados(fabs(valor));
+    uint64_t inteiro = centesimos / 100;
+    int fracao = (int) (centesimos % 100);
+
+    // dígitos da parte inteira, do menos para o mais significativo
+    char digitos[24];
+    int n = 0;
+    do {
+        digitos[n++] = (char) ('0' + inteiro % 10);
+        inteiro /= 10;
+    } while (inteiro > 0);
+    while (n > 0) {
+        *p++ = digitos[--n];
+    }
+
+    *p++ = '.';
+    *p++ = (char) ('0' + fracao / 10);
+    *p++ = (char) ('0' + fracao % 10);
+    *p = '\0';
+
+    return (int) (p - destino);
+}
+
+int formataInteiro(char *destino, long valor) {
+    char *p = destino;
+    if (valor < 0) {
+        *p++ = '-';
+    }
+
+    // trabalha com o valor absoluto em unsigned para cobrir LONG_MIN
+    unsigned long absoluto = (valor < 0) ? 0UL - (unsigned long) valor : (unsigned long) valor;
+    char digitos[24];
+    int n = 0;
+    do {
+        digitos[n++] = (char) ('0' + absoluto % 10);
+        absoluto /= 10;
+    } while (absoluto > 0);
+    while (n > 0) {
+        *p++ = digitos[--n];
+    }
+    *p = '\0';
+
+    return (int) (p - destino);
+}
@@ -0,0 +1,35 @@
+#ifndef FORMATANUMERO_H
+#define FORMATANUMERO_H
+
+/*
+*        MÓDULO: FORMATAÇÃO DE NÚMEROS
+*
+*        Rotinas de formatação usadas pelos escritores de saída (SVG e
+*        relatório .txt). Produzem exatamente os mesmos bytes que "%.2f" e
+*        "%ld" do printf (no decimal: arredondamento pelo valor binário
+*        exato, empate para o par, "-0.00" para negativos que arredondam a
+*        zero), sem passar pela formatação genérica da libc. Quem chama
+*        reserva o espaço; as rotinas não alocam nada.
+*/
+
+// maior saída possível de "%.2f" (DBL_MAX tem 309 dígitos), com o '\0'
+#define TAMANHO_MAX_DECIMAL 320
+
+/*
+Formata 'valor' como printf("%.2f", valor) em 'destino', que deve ter ao
+menos TAMANHO_MAX_DECIMAL bytes. Retorna o número de caracteres escritos
+(sem o '\0').
+*/
+int formataDecimal2(char *destino, double valor);
+
+// maior saída possível de "%ld" ("-9223372036854775808"), com o '\0'
+#define TAMANHO_MAX_INTEIRO 21
+
+/*
+Formata 'valor' como printf("%ld", valor) em 'destino', que deve ter ao
+menos TAMANHO_MAX_INTEIRO bytes. Retorna o número de caracteres escritos
+(sem o '\0').
+*/
+int formataInteiro(char *destino, long valor);
+
+#endif
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "perfil.h"
+#include "contadorAlocacoes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+// o ted tem poucas fases fixas; registros além destes limites são ignorados
+#define MAX_FASES_PERFIL 16
+#define MAX_VALORES_PERFIL 16
+
+typedef struct {
+    const char *nome;
+    double duracaoNs;
+    long alocacoes;
+    long rssPicoKiB;
+    int formasChao;
+    int formasArena;
+} FasePerfil;
+
+typedef struct {
+    const char *nome;
+    long valor;
+} ValorPerfil;
+
+typedef struct {
+    double inicioNs;
+
+    // fase em andamento
+    bool emFase;
+    double inicioFaseNs;
+    long alocacoesInicioFase;
+
+    FasePerfil fases[MAX_FASES_PERFIL];
+    int numFases;
+
+    ValorPerfil valores[MAX_VALORES_PERFIL];
+    int numValores;
+} PerfilC;
+
+
+/*________________________________ FUNÇÕES AUXILIARES ________________________________*/
+
+static double agoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// pico de memória residente do processo até agora (KiB, no Linux)
+static long rssPicoKiB() {
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) {
+        return -1;
+    }
+    return uso.ru_maxrss;
+}
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+Perfil criaPerfil() {
+    PerfilC *p = (PerfilC*) malloc(sizeof(PerfilC));
+    if (p == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    p->inicioNs = agoraNs();
+    p->emFase = false;
+    p->numFases = 0;
+    p->numValores = 0;
+    return (Perfil) p;
+}
+
+void destroiPerfil(Perfil p) {
+    free(p);
+}
+
+
+/*________________________________ FUNÇÕES DE MEDIÇÃO ________________________________*/
+
+void iniciaFasePerfil(Perfil p, const char *nome) {
+    PerfilC *perfil = (PerfilC*) p;
+    if (perfil == NULL || perfil->numFases >= MAX_FASES_PERFIL) {
+        return;
+    }
+    perfil->fases[perfil->numFases].nome = nome;
+    perfil->emFase = true;
+    perfil->alocacoesInicioFase = getNumAlocacoes();
+    perfil->inicioFaseNs = agoraNs();
+}
+
+MarcaPerfil marcaPerfil() {
+    MarcaPerfil marca;
+    marca.alocacoes = getNumAlocacoes();
+    marca.instanteNs = agoraNs();
+    return marca;
+}
+
+void iniciaFasePerfilDesde(Perfil p, const char *nome, MarcaPerfil marca) {
+    PerfilC *perfil = (PerfilC*) p;
+    iniciaFasePerfil(p, nome);
+    if (perfil == NULL || !perfil->emFase) {
+        return;
+    }
+    perfil->alocacoesInicioFase = marca.alocacoes;
+    perfil->inicioFaseNs = marca.instanteNs;
+    if (marca.instanteNs < perfil->inicioNs) {
+        perfil->inicioNs = marca.instanteNs;
+    }
+}
+
+void encerraFasePerfil(Perfil p, int formasChao, int formasArena) {
+    PerfilC *perfil = (PerfilC*) p;
+    if (perfil == NULL) {
+        return;
+    }
+    double fimNs = agoraNs();
+    if (!perfil->emFase) {
+        return;
+    }
+
+    FasePerfil *fase = &perfil->fases[perfil->numFases];
+    fase->duracaoNs = fimNs - perfil->inicioFaseNs;
+    fase->alocacoes = getNumAlocacoes() - perfil->alocacoesInicioFase;
+    fase->rssPicoKiB = rssPicoKiB();
+    fase->formasChao = formasChao;
+    fase->formasArena = formasArena;
+
+    perfil->numFases++;
+    perfil->emFase = false;
+}
+
+void registraValorPerfil(Perfil p, const char *nome, long valor) {
+    PerfilC *perfil = (PerfilC*) p;
+    if (perfil == NULL || perfil->numValores >= MAX_VALORES_PERFIL) {
+        return;
+    }
+    perfil->valores[perfil->numValores].nome = nome;
+    perfil->valores[perfil->numValores].valor = valor;
+    perfil->numValores++;
+}
+
+
+/*________________________________ SAÍDA ________________________________*/
+
+bool escrevePerfil(Perfil p, const char *caminho) {
+    PerfilC *perfil = (PerfilC*) p;
+    double totalNs = agoraNs() - perfil->inicioNs;
+
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
+        return false;
+    }
+
+    // os nomes são constantes do programa (sem aspas nem barras)
+    fprintf(arquivo, "{\n");
+    fprintf(arquivo, "  \"duracao_total_ms\": %.3f,\n", totalNs / 1e6);
+    fprintf(arquivo, "  \"rss_pico_kib\": %ld,\n", rssPicoKiB());
+    if (contagemAlocacoesAtiva()) {
+        fprintf(arquivo, "  \"alocacoes_total\": %ld,\n", getNumAlocacoes());
+    } else {
+        fprintf(arquivo, "  \"alocacoes_total\": null,\n");
+    }
+    for (int i = 0; i < perfil->numValores; i++) {
+        fprintf(arquivo, "  \"%s\": %ld,\n", perfil->valores[i].nome, perfil->valores[i].valor);
+    }
+
+    fprintf(arquivo, "  \"fases\": [");
+    for (int i = 0; i < perfil->numFases; i++) {
+        FasePerfil *fase = &perfil->fases[i];
+        fprintf(arquivo, "%s\n    {\"nome\": \"%s\", \"duracao_ms\": %.3f, ",
+                i == 0 ? "" : ",", fase->nome, fase->duracaoNs / 1e6);
+        if (contagemAlocacoesAtiva()) {
+            fprintf(arquivo, "\"alocacoes\": %ld, ", fase->alocacoes);
+        } else {
+            fprintf(arquivo, "\"alocacoes\": null, ");
+        }
+        fprintf(arquivo, "\"rss_pico_kib\": %ld, \"formas_chao\": %d, \"formas_arena\": %d}",
+                fase->rssPicoKiB, fase->formasChao, fase->formasArena);
+    }
+    fprintf(arquivo, "\n  ]\n}\n");
+
+    fclose(arquivo);
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include <stdbool.h>
+
+/*
+*        TIPO ABSTRATO DE DADOS: PERFIL DE EXECUÇÃO
+*
+*        Mede as fases de uma execução do ted (leitura da linha de comando,
+*        .geo, SVG inicial, .qry, SVG final...) e grava o resultado em JSON
+*        para acompanhar o programa entre versões e tamanhos de entrada.
+*
+*        Por fase: duração (relógio monotônico), alocações feitas durante a
+*        fase (contadorAlocacoes.h), pico de memória residente do processo
+*        até o fim da fase e quantas formas havia no Chão e na Arena no fim.
+*
+*        As funções de medição aceitam um perfil NULL e não fazem nada: quem
+*        só mede quando pedido (--profile) não precisa testar antes de cada
+*        chamada.
+*/
+
+typedef void *Perfil;
+
+// instante e alocações feitas até ele, para uma fase que começa antes de o perfil existir
+typedef struct {
+    double instanteNs;
+    long alocacoes;
+} MarcaPerfil;
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+/*
+Cria um perfil vazio; o tempo total é contado a partir daqui.
+
+* Pós-condição: retorna o perfil, ou o programa é encerrado em caso de
+* falha de alocação
+*/
+Perfil criaPerfil();
+
+// Libera o perfil (NULL é aceito)
+void destroiPerfil(Perfil p);
+
+
+/*________________________________ FUNÇÕES DE MEDIÇÃO ________________________________*/
+
+/*
+Começa a medir a fase 'nome' (a fase anterior deve ter sido encerrada).
+
+* nome: string constante (não é copiada)
+*/
+void iniciaFasePerfil(Perfil p, const char *nome);
+
+/*
+Tira uma marca do instante atual (não depende de um perfil; custa uma
+leitura do relógio).
+*/
+MarcaPerfil marcaPerfil();
+
+/*
+Como iniciaFasePerfil, mas a fase conta a partir de 'marca', tirada antes
+de o perfil ser criado (ex: antes de ler a linha de comando, que é onde se
+descobre se há perfil). O tempo total do perfil também passa a contar da
+marca.
+*/
+void iniciaFasePerfilDesde(Perfil p, const char *nome, MarcaPerfil marca);
+
+/*
+Encerra a fase em andamento, registrando as formas no Chão e na Arena.
+*/
+void encerraFasePerfil(Perfil p, int formasChao, int formasArena);
+
+/*
+Acrescenta um campo inteiro ao objeto principal do JSON (ex: parâmetros
+da execução).
+
+* nome: string constante (não é copiada)
+*/
+void registraValorPerfil(Perfil p, const char *nome, long valor);
+
+
+/*________________________________ SAÍDA ________________________________*/
+
+/*
+Grava o perfil em JSON no arquivo indicado.
+
+* Pós-condição: retorna false se o arquivo não puder ser criado
+*/
+bool escrevePerfil(Perfil p, const char *caminho);
+
+#endif
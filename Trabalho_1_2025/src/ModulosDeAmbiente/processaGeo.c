@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "processaGeo.h"
 
 #include "chao.h"
@@ -12,129 +14,493 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
 
-Chao processaGeo(const char *nome_path_geo) {
-    FILE *arquivo_geo = fopen(nome_path_geo, "r");
-    if (arquivo_geo == NULL) {
-        printf("Erro ao abrir o arquivo .geo: %s\n", nome_path_geo);
-        return NULL;
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+* O arquivo inteiro é mapeado em memória (MAP_PRIVATE: as escritas ficam
+* só na cópia do processo) e percorrido linha a linha, sem fgets nem sscanf:
+* - cada linha tem o '\n' trocado por '\0';
+* - o comando é escolhido pelo primeiro caractere do primeiro token;
+* - números são lidos por 'leDouble'/'leInt' direto do mapeamento;
+* - cores, textos e estilos são fatias do próprio arquivo, terminadas com
+* '\0' no lugar, sem cópia para buffers intermediários.
+*/
+
+
+/*________________________________ LEITURA DO ARQUIVO ________________________________*/
+
+typedef struct {
+    char *dados;
+    size_t tamanho;
+    bool mapeado;  // true: mmap; false: lido para um buffer com malloc
+} ArquivoGeo;
+
+// Mapeia o arquivo; se não for possível (ex: não é um arquivo regular),
+// lê o conteúdo inteiro para a memória
+static bool abreArquivoGeo(const char *caminho, ArquivoGeo *arq) {
+    arq->dados = NULL;
+    arq->tamanho = 0;
+    arq->mapeado = false;
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        return false;
     }
 
-    Chao meuChao = criaChao();
-    if (meuChao == NULL) {
-        printf("Erro ao criar o Chão!\n");
-        fclose(arquivo_geo);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        if (info.st_size == 0) {
+            close(fd);
+            return true;
+        }
+        void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            arq->dados = (char *)mapa;
+            arq->tamanho = (size_t)info.st_size;
+            arq->mapeado = true;
+            close(fd);
+            return true;
+        }
+    }
+
+    size_t capacidade = 0;
+    for (;;) {
+        if (arq->tamanho == capacidade) {
+            capacidade = (capacidade == 0) ? 65536 : capacidade * 2;
+            char *novo = (char *)realloc(arq->dados, capacidade);
+            if (novo == NULL) {
+                printf("Erro: falha na alocação de memória.\n");
+                exit(1);
+            }
+            arq->dados = novo;
+        }
+        ssize_t lidos = read(fd, arq->dados + arq->tamanho, capacidade - arq->tamanho);
+        if (lidos <= 0) {
+            break;
+        }
+        arq->tamanho += (size_t)lidos;
+    }
+    close(fd);
+    return true;
+}
+
+static void fechaArquivoGeo(ArquivoGeo *arq) {
+    if (arq->mapeado) {
+        munmap(arq->dados, arq->tamanho);
+    } else {
+        free(arq->dados);
+    }
+}
+
+
+/*________________________________ TOKENIZADOR ________________________________*/
+
+// mesmos separadores do "%s" do scanf
+static bool ehEspaco(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static char *pulaEspacos(char *p) {
+    while (*p != '\0' && ehEspaco(*p)) {
+        p++;
+    }
+    return p;
+}
+
+/*
+Encontra o próximo token a partir de *cursor, sem alterar a linha.
+Retorna o início do token (ou NULL se a linha acabou) e deixa *cursor
+logo após o seu último caractere. Só depois de achar todos os tokens
+da linha eles são terminados com 'terminaToken' (o '\0' escrito cairia
+no caminho do cursor).
+*/
+static char *achaToken(char **cursor) {
+    char *inicio = pulaEspacos(*cursor);
+    if (*inicio == '\0') {
+        *cursor = inicio;
         return NULL;
     }
 
-    char linha_buffer[512];
-    char comando[16];
+    char *fim = inicio;
+    while (*fim != '\0' && !ehEspaco(*fim)) {
+        fim++;
+    }
+    *cursor = fim;
+    return inicio;
+}
 
-    //estilo padrão para texto
-    char estilo_familia[64] = "sans-serif";
-    char estilo_peso[16] = "normal";
-    char estilo_tamanho[16] = "12";
+// Termina com '\0' o token que começa em 'inicio' (troca o separador seguinte)
+static char *terminaToken(char *inicio) {
+    char *fim = inicio;
+    while (*fim != '\0' && !ehEspaco(*fim)) {
+        fim++;
+    }
+    *fim = '\0';
+    return inicio;
+}
 
-    while (fgets(linha_buffer, sizeof(linha_buffer), arquivo_geo) != NULL) {
-        if (linha_buffer[0] == '\n' || linha_buffer[0] == '#') {
-            continue;
+// potências de 10 exatas em double
+static const double potencias10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+Lê um double a partir de *cursor (como o "%lf" do scanf).
+Caminho rápido: mantissa decimal de no máximo 2^53 e expoente decimal de
+até 22 em módulo. Nesse caso mantissa e potência são exatas em double e
+uma única multiplicação/divisão dá o mesmo valor arredondado que strtod.
+Qualquer outra grafia (hexadecimal, inf, nan, muitos dígitos) vai para strtod.
+*/
+static bool leDouble(char **cursor, double *valor) {
+    char *inicio = pulaEspacos(*cursor);
+    char *p = inicio;
+
+    bool negativo = false;
+    if (*p == '-' || *p == '+') {
+        negativo = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digitos = 0;  // dígitos significativos (sem zeros à esquerda)
+    int expoente = 0;
+    bool algumDigito = false;
+
+    while (*p >= '0' && *p <= '9') {
+        algumDigito = true;
+        if (mantissa != 0 || *p != '0') {
+            digitos++;
+        }
+        if (digitos <= 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
         }
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') {
+            algumDigito = true;
+            if (mantissa != 0 || *p != '0') {
+                digitos++;
+            }
+            if (digitos <= 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                expoente--;
+            }
+            p++;
+        }
+    }
+    if (algumDigito && (*p == 'e' || *p == 'E')) {
+        char *q = p + 1;
+        bool expNegativo = false;
+        if (*q == '-' || *q == '+') {
+            expNegativo = (*q == '-');
+            q++;
+        }
+        if (*q >= '0' && *q <= '9') {
+            int e = 0;
+            while (*q >= '0' && *q <= '9') {
+                if (e < 10000) {
+                    e = e * 10 + (*q - '0');
+                }
+                q++;
+            }
+            expoente += expNegativo ? -e : e;
+            p = q;
+        }
+    }
+
+    bool terminou = (*p == '\0' || ehEspaco(*p));
+    if (algumDigito && terminou && digitos <= 19 &&
+        mantissa <= ((uint64_t)1 << 53) && expoente >= -22 && expoente <= 22) {
+        double v = (double)mantissa;
+        v = (expoente < 0) ? v / potencias10[-expoente] : v * potencias10[expoente];
+        *valor = negativo ? -v : v;
+        *cursor = p;
+        return true;
+    }
 
-        sscanf(linha_buffer, "%s", comando);
+    char *fim;
+    double v = strtod(inicio, &fim);
+    if (fim == inicio) {
+        return false;
+    }
+    *valor = v;
+    *cursor = fim;
+    return true;
+}
+
+// Lê um inteiro a partir de *cursor (como o "%d" do scanf)
+static bool leInt(char **cursor, int *valor) {
+    char *inicio = pulaEspacos(*cursor);
+    char *p = inicio;
+
+    bool negativo = false;
+    if (*p == '-' || *p == '+') {
+        negativo = (*p == '-');
+        p++;
+    }
+
+    long v = 0;
+    int digitos = 0;
+    while (*p >= '0' && *p <= '9' && digitos < 9) {
+        v = v * 10 + (*p - '0');
+        digitos++;
+        p++;
+    }
+
+    if (digitos > 0 && (*p < '0' || *p > '9')) {
+        *valor = (int)(negativo ? -v : v);
+        *cursor = p;
+        return true;
+    }
+
+    char *fim;
+    v = strtol(inicio, &fim, 10);
+    if (fim == inicio) {
+        return false;
+    }
+    *valor = (int)v;
+    *cursor = fim;
+    return true;
+}
+
+
+/*________________________________ COMANDOS ________________________________*/
+
+typedef struct {
+    Chao chao;
+    //valores do último 'ts' (fatias do arquivo, válidas até o fim da leitura)
+    char *estilo_familia;
+    char *estilo_peso;
+    char *estilo_tamanho;
+    //estilo corrente, compartilhado por todos os textos até o próximo 'ts'
+    Estilo estilo_atual;
+} EstadoGeo;
+
+// Copia um token para um buffer local (limitado ao tamanho do buffer)
+static void copiaToken(char *destino, int tamMax, const char *token) {
+    int i = 0;
+    while (i < tamMax - 1 && token[i] != '\0' && !ehEspaco(token[i])) {
+        destino[i] = token[i];
+        i++;
+    }
+    destino[i] = '\0';
+}
+
+/*
+Processa uma linha terminada em '\0' (sem o '\n').
+Retorna false se a linha não for um comando válido; nesse caso a linha
+não foi alterada e pode ser impressa na mensagem de erro. Um c/r/l/t com
+campos faltando ou não numéricos também é inválido: a forma não é criada
+(o leitor com sscanf a criava com os valores que sobravam nas variáveis).
+*/
+static bool processaLinhaGeo(char *linha, EstadoGeo *estado) {
+    char *cursor = linha;
+    char *comando = achaToken(&cursor);
+    if (comando == NULL) {
+        return true;  //linha só com espaços
+    }
+    size_t tamComando = (size_t)(cursor - comando);
+
+    switch (comando[0]) {
+        case 'c': {
+            if (tamComando != 1) return false;
 
-        if (strcmp(comando, "c") == 0) {
             int id;
             double x, y, r;
-            char corb[64], corp[64];
-
-            sscanf(linha_buffer, "c %d %lf %lf %lf %s %s", &id, &x, &y, &r, corb, corp);
+            if (!leInt(&cursor, &id) || !leDouble(&cursor, &x) || !leDouble(&cursor, &y) ||
+                !leDouble(&cursor, &r)) {
+                return false;
+            }
+            char *corb = achaToken(&cursor);
+            char *corp = achaToken(&cursor);
+            if (corp == NULL) return false;
 
-            Circulo c = criarCirculo(id, x, y, r, corb, corp, false, 0);
+            Circulo c = criarCirculo(id, x, y, r, terminaToken(corb), terminaToken(corp), false, 0);
             Forma f = criaForma(id, TIPO_CIRCULO, c);
-            adicionaFormaChao(meuChao, f);
+            adicionaFormaChao(estado->chao, f);
+            return true;
         }
 
-        else if (strcmp(comando, "r") == 0) {
+        case 'r': {
+            if (tamComando != 1) return false;
+
             int id;
             double x, y, w, h;
-            char corb[64], corp[64];
-
-            sscanf(linha_buffer, "r %d %lf %lf %lf %lf %s %s", &id, &x, &y, &w, &h, corb, corp);
+            if (!leInt(&cursor, &id) || !leDouble(&cursor, &x) || !leDouble(&cursor, &y) ||
+                !leDouble(&cursor, &w) || !leDouble(&cursor, &h)) {
+                return false;
+            }
+            char *corb = achaToken(&cursor);
+            char *corp = achaToken(&cursor);
+            if (corp == NULL) return false;
 
-            Retangulo rt = criarRetangulo(id, x, y, w, h, corb, corp, false, 0);
+            Retangulo rt = criarRetangulo(id, x, y, w, h, terminaToken(corb), terminaToken(corp), false, 0);
             Forma f = criaForma(id, TIPO_RETANGULO, rt);
-            adicionaFormaChao(meuChao, f);
+            adicionaFormaChao(estado->chao, f);
+            return true;
         }
 
-        else if (strcmp(comando, "l") == 0) {
+        case 'l': {
+            if (tamComando != 1) return false;
+
             int id;
             double x1, y1, x2, y2;
-            char cor[64];
-
-            sscanf(linha_buffer, "l %d %lf %lf %lf %lf %s", &id, &x1, &y1, &x2, &y2, cor);
+            if (!leInt(&cursor, &id) || !leDouble(&cursor, &x1) || !leDouble(&cursor, &y1) ||
+                !leDouble(&cursor, &x2) || !leDouble(&cursor, &y2)) {
+                return false;
+            }
+            char *cor = achaToken(&cursor);
+            if (cor == NULL) return false;
 
-            Linha l = criarLinha(id, x1, y1, x2, y2, cor, false, 0);
+            Linha l = criarLinha(id, x1, y1, x2, y2, terminaToken(cor), false, 0);
             Forma f = criaForma(id, TIPO_LINHA, l);
-            adicionaFormaChao(meuChao, f);
+            adicionaFormaChao(estado->chao, f);
+            return true;
         }
 
-        else if (strcmp(comando, "t") == 0) {
+        case 't': {
+            if (tamComando == 2 && comando[1] == 's') {
+                //'ts' atualiza só os campos presentes, como o sscanf fazia
+                char *familia = achaToken(&cursor);
+                char *peso = (familia != NULL) ? achaToken(&cursor) : NULL;
+                char *tamanho = (peso != NULL) ? achaToken(&cursor) : NULL;
+
+                if (familia != NULL) estado->estilo_familia = terminaToken(familia);
+                if (peso != NULL) estado->estilo_peso = terminaToken(peso);
+                if (tamanho != NULL) estado->estilo_tamanho = terminaToken(tamanho);
+
+                //textos já criados continuam com o estilo antigo
+                destroiEstilo(estado->estilo_atual);
+                estado->estilo_atual = criarEstilo(estado->estilo_familia, estado->estilo_peso,
+                                                   estado->estilo_tamanho);
+                return true;
+            }
+            if (tamComando != 1) return false;
+
             int id;
             double x, y;
-            char corb[64], corp[64];
-            char ancora;
-            char conteudo_texto[256] = ""; //inicializa como string vazia
+            if (!leInt(&cursor, &id) || !leDouble(&cursor, &x) || !leDouble(&cursor, &y)) {
+                return false;
+            }
+            char *tokCorb = achaToken(&cursor);
+            char *tokCorp = achaToken(&cursor);
+            if (tokCorp == NULL) return false;
 
-            sscanf(linha_buffer, "t %d %lf %lf %s %s", &id, &x, &y, corb, corp);
+            //as cores são copiadas: com espaços repetidos a âncora (abaixo)
+            //pode cair dentro delas, então a linha não é alterada antes
+            char corb[64], corp[64];
+            copiaToken(corb, sizeof(corb), tokCorb);
+            copiaToken(corp, sizeof(corp), tokCorp);
 
-            //extrair âncora e texto
-            char *ptr = linha_buffer;
+            //a âncora é o caractere logo após o 6º espaço da linha (contando
+            //do início) e o texto é o resto da linha após ela
+            char *ptr = linha;
             int espacos_encontrados = 0;
-
-            //avança o ponteiro até após o 6º espaço (após corp)
             while (*ptr && espacos_encontrados < 6) {
                 if (*ptr == ' ') {
                     espacos_encontrados++;
                 }
                 ptr++;
             }
-            
-            //agora ptr na âncora.
+
+            char ancora = 'i';
+            char *conteudo_texto = ptr;  //vazio se a linha acabou
             if (*ptr) {
                 ancora = *ptr;
                 ptr++;  //avança pra após a âncora.
-                
+
                 //pula espaços em branco
-                while (*ptr && isspace(*ptr)) {
+                while (*ptr && isspace((unsigned char)*ptr)) {
                     ptr++;
                 }
-                
-                //resto = o texto
-                char *inicio_texto = ptr;
-                if (*inicio_texto) {
-                    inicio_texto[strcspn(inicio_texto, "\r\n")] = '\0';
-                    strcpy(conteudo_texto, inicio_texto);
-                }
+
+                //resto = o texto (até o fim da linha ou um '\r')
+                conteudo_texto = ptr;
+                conteudo_texto[strcspn(conteudo_texto, "\r")] = '\0';
             }
-            
-            Estilo e = criarEstilo(estilo_familia, estilo_peso, estilo_tamanho);
-            Texto t = criarTexto(id, x, y, corb, corp, ancora, conteudo_texto, e);
+
+            Texto t = criarTexto(id, x, y, corb, corp, ancora, conteudo_texto, estado->estilo_atual);
             Forma f = criaForma(id, TIPO_TEXTO, t);
+            adicionaFormaChao(estado->chao, f);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*________________________________ FUNÇÃO DE PROCESSAMENTO ________________________________*/
+
+Chao processaGeo(const char *nome_path_geo) {
+    ArquivoGeo arquivo_geo;
+    if (!abreArquivoGeo(nome_path_geo, &arquivo_geo)) {
+        printf("Erro ao abrir o arquivo .geo: %s\n", nome_path_geo);
+        return NULL;
+    }
+
+    Chao meuChao = criaChao();
+    if (meuChao == NULL) {
+        printf("Erro ao criar o Chão!\n");
+        fechaArquivoGeo(&arquivo_geo);
+        return NULL;
+    }
 
-            adicionaFormaChao(meuChao, f);
+    //estilo padrão para texto
+    EstadoGeo estado;
+    estado.chao = meuChao;
+    estado.estilo_familia = "sans-serif";
+    estado.estilo_peso = "normal";
+    estado.estilo_tamanho = "12";
+    estado.estilo_atual = criarEstilo(estado.estilo_familia, estado.estilo_peso, estado.estilo_tamanho);
+
+    //a última linha, se não terminar em '\n', é copiada para ter onde pôr o '\0'
+    char *ultima_linha = NULL;
+
+    char *p = arquivo_geo.dados;
+    char *fim_arquivo = arquivo_geo.dados + arquivo_geo.tamanho;
+
+    while (p < fim_arquivo) {
+        char *linha = p;
+        char *fim_linha = memchr(p, '\n', (size_t)(fim_arquivo - p));
+        bool tem_quebra = (fim_linha != NULL);
 
-            //destroi pq foi copiado
-            destroiEstilo(e);
+        if (tem_quebra) {
+            *fim_linha = '\0';
+            p = fim_linha + 1;
+        } else {
+            size_t tamanho = (size_t)(fim_arquivo - p);
+            ultima_linha = (char *)malloc(tamanho + 1);
+            if (ultima_linha == NULL) {
+                printf("Erro: falha na alocação de memória.\n");
+                exit(1);
+            }
+            memcpy(ultima_linha, p, tamanho);
+            ultima_linha[tamanho] = '\0';
+            linha = ultima_linha;
+            p = fim_arquivo;
         }
 
-        else if (strcmp(comando, "ts") == 0) {
-            sscanf(linha_buffer, "ts %s %s %s", estilo_familia, estilo_peso, estilo_tamanho);
+        if (linha[0] == '\0' || linha[0] == '#') {
+            continue;
         }
-        else {
-             printf("Comando desconhecido ou mal formatado na linha: %s\n", linha_buffer);
+
+        //linha inválida não cria forma; a leitura segue na próxima
+        if (!processaLinhaGeo(linha, &estado)) {
+            printf("Comando desconhecido ou mal formatado na linha: %s%s\n", linha, tem_quebra ? "\n" : "");
         }
     }
 
-    fclose(arquivo_geo);
+    destroiEstilo(estado.estilo_atual);
+    free(ultima_linha);
+    fechaArquivoGeo(&arquivo_geo);
     return meuChao;
-}
\ No newline at end of file
+}
@@ -27,7 +27,9 @@ as adicionando ao Chao.
 *       geo existente e legível
 *       Pós-condição: retorna um ponteiro para o Chão contendo todas as formas
 *       criadas e adicionadas, ou NULL em caso de erro na abertura
-*       do arquivo.
+*       do arquivo. Linhas com comando desconhecido ou mal formatadas (c, r,
+*       l ou t com campos faltando ou não numéricos) são ignoradas, com a
+*       mensagem "Comando desconhecido ou mal formatado", e não criam forma.
 */
 Chao processaGeo(const char *nome_path_geo);
 
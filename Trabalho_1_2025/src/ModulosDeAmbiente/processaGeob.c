@@ -0,0 +1,649 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "processaGeob.h"
+
+#include "chao.h"
+
+#include "circulo.h"
+#include "linha.h"
+#include "retangulo.h"
+#include "texto.h"
+#include "formas.h"
+#include "cores.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/*________________________________ FORMATO ________________________________*/
+
+#define ASSINATURA_GEOB "TEDGEOB"
+#define VERSAO_GEOB 2
+#define MARCA_ORDEM_GEOB 0x01020304u
+
+// tipo gravado no início de cada registro (valores fixos do formato)
+enum {
+    REGISTRO_CIRCULO = 1,
+    REGISTRO_RETANGULO = 2,
+    REGISTRO_LINHA = 3,
+    REGISTRO_TEXTO = 4
+};
+
+typedef struct {
+    char assinatura[8];
+    uint32_t versao;
+    uint32_t marcaOrdem;
+    uint64_t numFormas;
+    uint64_t numCirculos, numRetangulos, numLinhas, numTextos;
+    uint64_t inicioRegistros, tamanhoRegistros;
+    uint64_t inicioCores, numCores;
+    uint64_t inicioEstilos, numEstilos;
+    uint64_t inicioStrings, tamanhoStrings;
+} CabecalhoGeob;
+
+/*
+Registros sem preenchimento entre os campos (packed), para o arquivo
+ocupar o mínimo; o compilador gera os acessos desalinhados sozinho.
+Cores são índices na tabela de cores (COR_GEOB_NENHUMA para uma forma sem
+cor, COR_INDEFINIDA); conteúdo e estilo de texto são, respectivamente,
+deslocamento na tabela de strings e índice na de estilos.
+*/
+#define COR_GEOB_NENHUMA UINT32_MAX
+
+typedef struct __attribute__((packed)) {
+    uint8_t tipo;
+    int32_t id;
+    double x, y, r;
+    uint32_t corb, corp;
+} RegistroCirculo;
+
+typedef struct __attribute__((packed)) {
+    uint8_t tipo;
+    int32_t id;
+    double x, y, w, h;
+    uint32_t corb, corp;
+} RegistroRetangulo;
+
+typedef struct __attribute__((packed)) {
+    uint8_t tipo;
+    int32_t id;
+    double x1, y1, x2, y2;
+    uint32_t cor;
+} RegistroLinha;
+
+typedef struct __attribute__((packed)) {
+    uint8_t tipo;
+    int32_t id;
+    double x, y;
+    uint32_t corb, corp;
+    uint32_t conteudo;
+    uint32_t estilo;
+    char ancora;
+} RegistroTexto;
+
+// deslocamentos na tabela de strings
+typedef struct {
+    uint32_t familia, peso, tamanho;
+} RegistroEstilo;
+
+
+/*________________________________ ESCRITA ________________________________*/
+
+typedef struct {
+    FILE *arquivo;
+    bool falhou;
+    CabecalhoGeob cab;
+
+    // tabela de strings, montada em memória e gravada no fim
+    char *strings;
+    size_t tamStrings;
+    size_t capStrings;
+
+    // espalhamento das strings já gravadas: cada posição guarda o
+    // deslocamento + 1 da string (0: vazia); dobra ao passar da metade
+    uint32_t *posicoesString;
+    size_t capPosicoes;
+    size_t numStringsDistintas;
+
+    // índice + 1 na tabela de cores de cada IdCor já visto (0: ainda não)
+    uint32_t *indiceDaCor;
+    int capIndiceDaCor;
+    uint32_t *cores;  // deslocamento do nome de cada cor
+    uint32_t numCores;
+    uint32_t capCores;
+
+    // estilos distintos já vistos (ponteiros dos dados compartilhados)
+    const char **estilos;  // trios família, peso, tamanho
+    RegistroEstilo *registrosEstilo;
+    int numEstilos;
+    int capEstilos;
+    int ultimoEstilo;
+} EscritaGeob;
+
+static void *realocaOuEncerra(void *p, size_t tam) {
+    void *novo = realloc(p, tam);
+    if (novo == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    return novo;
+}
+
+// FNV-1a
+static uint32_t espalhaString(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// posição de 's' no espalhamento das strings, ou a vazia onde ela entraria
+static size_t posicaoDaString(const EscritaGeob *e, const char *s, uint32_t h) {
+    size_t mascara = e->capPosicoes - 1;
+    size_t pos = h & mascara;
+    while (e->posicoesString[pos] != 0 &&
+           strcmp(e->strings + e->posicoesString[pos] - 1, s) != 0) {
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+static void cresceEspalhamentoStrings(EscritaGeob *e) {
+    uint32_t *antigas = e->posicoesString;
+    size_t capAntiga = e->capPosicoes;
+
+    e->capPosicoes = (capAntiga == 0) ? 1024 : capAntiga * 2;
+    e->posicoesString = (uint32_t *)calloc(e->capPosicoes, sizeof(uint32_t));
+    if (e->posicoesString == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < capAntiga; i++) {
+        if (antigas[i] != 0) {
+            const char *s = e->strings + antigas[i] - 1;
+            e->posicoesString[posicaoDaString(e, s, espalhaString(s))] = antigas[i];
+        }
+    }
+    free(antigas);
+}
+
+/*
+Deslocamento de 's' na tabela de strings; cada string distinta é gravada
+uma vez só. Os deslocamentos têm 32 bits: se a tabela passar de 4 GiB a
+escrita falha.
+*/
+static uint32_t internaStringGeob(EscritaGeob *e, const char *s) {
+    if (2 * (e->numStringsDistintas + 1) > e->capPosicoes) {
+        cresceEspalhamentoStrings(e);
+    }
+    uint32_t h = espalhaString(s);
+    size_t pos = posicaoDaString(e, s, h);
+    if (e->posicoesString[pos] != 0) {
+        return e->posicoesString[pos] - 1;
+    }
+
+    size_t tam = strlen(s) + 1;
+    if (e->tamStrings + tam >= UINT32_MAX) {
+        e->falhou = true;
+        return 0;
+    }
+    if (e->tamStrings + tam > e->capStrings) {
+        size_t cap = (e->capStrings == 0) ? 65536 : e->capStrings;
+        while (e->tamStrings + tam > cap) {
+            cap *= 2;
+        }
+        e->strings = (char *)realocaOuEncerra(e->strings, cap);
+        e->capStrings = cap;
+    }
+    uint32_t deslocamento = (uint32_t)e->tamStrings;
+    memcpy(e->strings + e->tamStrings, s, tam);
+    e->tamStrings += tam;
+
+    e->posicoesString[pos] = deslocamento + 1;
+    e->numStringsDistintas++;
+    return deslocamento;
+}
+
+// índice da cor na tabela de cores; o IdCor evita consultar o nome de novo
+static uint32_t indiceDaCor(EscritaGeob *e, IdCor cor) {
+    if (cor < 0) {
+        return COR_GEOB_NENHUMA;
+    }
+    if (cor >= e->capIndiceDaCor) {
+        int cap = (e->capIndiceDaCor == 0) ? 64 : e->capIndiceDaCor;
+        while (cor >= cap) {
+            cap *= 2;
+        }
+        e->indiceDaCor = (uint32_t *)realocaOuEncerra(e->indiceDaCor, (size_t)cap * sizeof(uint32_t));
+        memset(e->indiceDaCor + e->capIndiceDaCor, 0, (size_t)(cap - e->capIndiceDaCor) * sizeof(uint32_t));
+        e->capIndiceDaCor = cap;
+    }
+    if (e->indiceDaCor[cor] == 0) {
+        if (e->numCores == e->capCores) {
+            e->capCores = (e->capCores == 0) ? 64 : e->capCores * 2;
+            e->cores = (uint32_t *)realocaOuEncerra(e->cores, (size_t)e->capCores * sizeof(uint32_t));
+        }
+        e->cores[e->numCores] = internaStringGeob(e, getNomeCor(cor));
+        e->indiceDaCor[cor] = ++e->numCores;
+    }
+    return e->indiceDaCor[cor] - 1;
+}
+
+// textos com o mesmo estilo compartilham os dados, então os ponteiros bastam
+static uint32_t indiceDoEstilo(EscritaGeob *e, Estilo estilo) {
+    const char *familia = getFamily(estilo);
+    const char *peso = getWeight(estilo);
+    const char *tamanho = getSize(estilo);
+
+    int ultimo = e->ultimoEstilo;
+    if (ultimo < e->numEstilos && e->estilos[3 * ultimo] == familia &&
+        e->estilos[3 * ultimo + 1] == peso && e->estilos[3 * ultimo + 2] == tamanho) {
+        return (uint32_t)ultimo;
+    }
+    for (int k = 0; k < e->numEstilos; k++) {
+        if (e->estilos[3 * k] == familia && e->estilos[3 * k + 1] == peso &&
+            e->estilos[3 * k + 2] == tamanho) {
+            e->ultimoEstilo = k;
+            return (uint32_t)k;
+        }
+    }
+
+    if (e->numEstilos == e->capEstilos) {
+        e->capEstilos = (e->capEstilos == 0) ? 8 : e->capEstilos * 2;
+        e->estilos = (const char **)realocaOuEncerra(e->estilos, (size_t)e->capEstilos * 3 * sizeof(char *));
+        e->registrosEstilo = (RegistroEstilo *)realocaOuEncerra(e->registrosEstilo,
+                                                                (size_t)e->capEstilos * sizeof(RegistroEstilo));
+    }
+    int k = e->numEstilos++;
+    e->estilos[3 * k] = familia;
+    e->estilos[3 * k + 1] = peso;
+    e->estilos[3 * k + 2] = tamanho;
+    e->registrosEstilo[k].familia = internaStringGeob(e, familia);
+    e->registrosEstilo[k].peso = internaStringGeob(e, peso);
+    e->registrosEstilo[k].tamanho = internaStringGeob(e, tamanho);
+    e->ultimoEstilo = k;
+    return (uint32_t)k;
+}
+
+static void gravaRegistro(EscritaGeob *e, const void *registro, size_t tam) {
+    if (!e->falhou && fwrite(registro, tam, 1, e->arquivo) != 1) {
+        e->falhou = true;
+    }
+    e->cab.tamanhoRegistros += tam;
+    e->cab.numFormas++;
+}
+
+// Callback de iteraFormasChao: grava o registro da forma
+static void escreveFormaGeob(Forma f, void *aux) {
+    EscritaGeob *e = (EscritaGeob *)aux;
+    void *dados = getFormaAssoc(f);
+
+    switch (getFormaTipo(f)) {
+        case TIPO_CIRCULO: {
+            RegistroCirculo r = {
+                .tipo = REGISTRO_CIRCULO, .id = getFormaId(f),
+                .x = getXCirculo(dados), .y = getYCirculo(dados), .r = getRCirculo(dados),
+                .corb = indiceDaCor(e, getIdCorbCirculo(dados)),
+                .corp = indiceDaCor(e, getIdCorpCirculo(dados))
+            };
+            gravaRegistro(e, &r, sizeof(r));
+            e->cab.numCirculos++;
+            break;
+        }
+        case TIPO_RETANGULO: {
+            RegistroRetangulo r = {
+                .tipo = REGISTRO_RETANGULO, .id = getFormaId(f),
+                .x = getXRetangulo(dados), .y = getYRetangulo(dados),
+                .w = getLarguraRetangulo(dados), .h = getAlturaRetangulo(dados),
+                .corb = indiceDaCor(e, getIdCorbRetangulo(dados)),
+                .corp = indiceDaCor(e, getIdCorpRetangulo(dados))
+            };
+            gravaRegistro(e, &r, sizeof(r));
+            e->cab.numRetangulos++;
+            break;
+        }
+        case TIPO_LINHA: {
+            RegistroLinha r = {
+                .tipo = REGISTRO_LINHA, .id = getFormaId(f),
+                .x1 = getX1Linha(dados), .y1 = getY1Linha(dados),
+                .x2 = getX2Linha(dados), .y2 = getY2Linha(dados),
+                .cor = indiceDaCor(e, getIdCorLinha(dados))
+            };
+            gravaRegistro(e, &r, sizeof(r));
+            e->cab.numLinhas++;
+            break;
+        }
+        case TIPO_TEXTO: {
+            RegistroTexto r = {
+                .tipo = REGISTRO_TEXTO, .id = getFormaId(f),
+                .x = getXTexto(dados), .y = getYTexto(dados),
+                .corb = indiceDaCor(e, getIdCorbTexto(dados)),
+                .corp = indiceDaCor(e, getIdCorpTexto(dados)),
+                .conteudo = internaStringGeob(e, getTexto(dados)),
+                .estilo = indiceDoEstilo(e, getEstiloTexto(dados)),
+                .ancora = getAncora(dados)
+            };
+            gravaRegistro(e, &r, sizeof(r));
+            e->cab.numTextos++;
+            break;
+        }
+    }
+}
+
+// Grava 'n' itens de 'tam' bytes, marcando a falha se houver
+static void gravaSecao(EscritaGeob *e, const void *dados, size_t tam, size_t n) {
+    if (n > 0 && fwrite(dados, tam, n, e->arquivo) != n) {
+        e->falhou = true;
+    }
+}
+
+bool escreveGeob(Chao chao, const char *caminho) {
+    FILE *arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL) {
+        return false;
+    }
+    setvbuf(arquivo, NULL, _IOFBF, 1 << 20);
+
+    EscritaGeob e;
+    memset(&e, 0, sizeof(e));
+    e.arquivo = arquivo;
+    memcpy(e.cab.assinatura, ASSINATURA_GEOB, sizeof(ASSINATURA_GEOB));
+    e.cab.versao = VERSAO_GEOB;
+    e.cab.marcaOrdem = MARCA_ORDEM_GEOB;
+    e.cab.inicioRegistros = sizeof(CabecalhoGeob);
+
+    //o cabeçalho é regravado no fim, com as contagens e as posições
+    gravaSecao(&e, &e.cab, sizeof(e.cab), 1);
+    iteraFormasChao(chao, escreveFormaGeob, &e);
+
+    //as tabelas seguintes são lidas direto do mapeamento, então começam alinhadas
+    static const char zeros[8] = { 0 };
+    size_t preenchimento = (size_t)(-e.cab.tamanhoRegistros & 7);
+    gravaSecao(&e, zeros, 1, preenchimento);
+
+    e.cab.inicioCores = e.cab.inicioRegistros + e.cab.tamanhoRegistros + preenchimento;
+    e.cab.numCores = e.numCores;
+    e.cab.inicioEstilos = e.cab.inicioCores + e.cab.numCores * sizeof(uint32_t);
+    e.cab.numEstilos = (uint64_t)e.numEstilos;
+    e.cab.inicioStrings = e.cab.inicioEstilos + e.cab.numEstilos * sizeof(RegistroEstilo);
+    e.cab.tamanhoStrings = e.tamStrings;
+
+    gravaSecao(&e, e.cores, sizeof(uint32_t), e.numCores);
+    gravaSecao(&e, e.registrosEstilo, sizeof(RegistroEstilo), (size_t)e.numEstilos);
+    gravaSecao(&e, e.strings, 1, e.tamStrings);
+    if (fseek(arquivo, 0, SEEK_SET) != 0) {
+        e.falhou = true;
+    }
+    gravaSecao(&e, &e.cab, sizeof(e.cab), 1);
+    if (fclose(arquivo) != 0) {
+        e.falhou = true;
+    }
+
+    free(e.strings);
+    free(e.posicoesString);
+    free(e.indiceDaCor);
+    free(e.cores);
+    free(e.estilos);
+    free(e.registrosEstilo);
+    return !e.falhou;
+}
+
+
+/*________________________________ LEITURA ________________________________*/
+
+typedef struct {
+    const char *base;
+    size_t tamanho;
+    const CabecalhoGeob *cab;
+    const char *strings;
+    const uint32_t *cores;
+    const RegistroEstilo *registrosEstilo;
+    IdCor *idsCores;  // IdCor + 1 de cada cor já internada (0: ainda não)
+    Estilo *estilos;  // criados na primeira vez que um texto os usa
+} LeituraGeob;
+
+// true se [inicio, inicio + tam) cabe no arquivo
+static bool secaoValida(const LeituraGeob *l, uint64_t inicio, uint64_t tam) {
+    return inicio <= l->tamanho && tam <= l->tamanho - inicio;
+}
+
+// Transforma um deslocamento da tabela em ponteiro (NULL se inválido)
+static const char *stringGeob(const LeituraGeob *l, uint32_t deslocamento) {
+    if (deslocamento >= l->cab->tamanhoStrings) {
+        return NULL;
+    }
+    return l->strings + deslocamento;
+}
+
+/*
+IdCor da cor de índice 'indice'. Cada cor passa pela tabela de cores uma
+vez só, na primeira forma que a usa (a mesma ordem da leitura do .geo, então
+os IdCor saem iguais); as demais formas só copiam o IdCor.
+COR_GEOB_NENHUMA volta a ser COR_INDEFINIDA.
+*/
+static bool corGeob(LeituraGeob *l, uint32_t indice, IdCor *cor) {
+    if (indice == COR_GEOB_NENHUMA) {
+        *cor = COR_INDEFINIDA;
+        return true;
+    }
+    if (indice >= l->cab->numCores) {
+        return false;
+    }
+    if (l->idsCores[indice] == 0) {
+        const char *nome = stringGeob(l, l->cores[indice]);
+        if (nome == NULL) {
+            return false;
+        }
+        l->idsCores[indice] = internaCor(nome) + 1;
+    }
+    *cor = l->idsCores[indice] - 1;
+    return true;
+}
+
+static Estilo estiloGeob(LeituraGeob *l, uint32_t indice) {
+    if (indice >= l->cab->numEstilos) {
+        return NULL;
+    }
+    if (l->estilos[indice] == NULL) {
+        const RegistroEstilo *r = &l->registrosEstilo[indice];
+        const char *familia = stringGeob(l, r->familia);
+        const char *peso = stringGeob(l, r->peso);
+        const char *tamanho = stringGeob(l, r->tamanho);
+        if (familia == NULL || peso == NULL || tamanho == NULL) {
+            return NULL;
+        }
+        l->estilos[indice] = criarEstilo(familia, peso, tamanho);
+    }
+    return l->estilos[indice];
+}
+
+static bool cabecalhoValido(LeituraGeob *l) {
+    if (l->tamanho < sizeof(CabecalhoGeob)) {
+        return false;
+    }
+    const CabecalhoGeob *cab = (const CabecalhoGeob *)l->base;
+    l->cab = cab;
+    if (memcmp(cab->assinatura, ASSINATURA_GEOB, sizeof(ASSINATURA_GEOB)) != 0 ||
+        cab->versao != VERSAO_GEOB || cab->marcaOrdem != MARCA_ORDEM_GEOB) {
+        return false;
+    }
+    if (cab->inicioCores % sizeof(uint32_t) != 0 || cab->inicioEstilos % sizeof(uint32_t) != 0 ||
+        cab->tamanhoStrings > UINT32_MAX ||
+        !secaoValida(l, cab->inicioRegistros, cab->tamanhoRegistros) ||
+        !secaoValida(l, cab->inicioStrings, cab->tamanhoStrings) ||
+        cab->inicioCores > l->tamanho ||
+        cab->numCores > (l->tamanho - cab->inicioCores) / sizeof(uint32_t) ||
+        cab->inicioEstilos > l->tamanho ||
+        cab->numEstilos > (l->tamanho - cab->inicioEstilos) / sizeof(RegistroEstilo)) {
+        return false;
+    }
+    //com a última string terminada, todas as outras também estão
+    if (cab->tamanhoStrings > 0 && l->base[cab->inicioStrings + cab->tamanhoStrings - 1] != '\0') {
+        return false;
+    }
+    l->strings = l->base + cab->inicioStrings;
+    l->cores = (const uint32_t *)(l->base + cab->inicioCores);
+    l->registrosEstilo = (const RegistroEstilo *)(l->base + cab->inicioEstilos);
+    return true;
+}
+
+/*
+Cria a forma do registro em 'p' e a adiciona ao Chão. As cores entram
+como IdCor já resolvido (setIdCor*), sem consultar a tabela de cores.
+Retorna o tamanho do registro, ou 0 se ele for inválido.
+*/
+static size_t leRegistroGeob(LeituraGeob *l, const char *p, size_t restante, Chao chao) {
+    switch ((uint8_t)*p) {
+        case REGISTRO_CIRCULO: {
+            if (restante < sizeof(RegistroCirculo)) return 0;
+            const RegistroCirculo *r = (const RegistroCirculo *)p;
+            IdCor corb, corp;
+            if (!corGeob(l, r->corb, &corb) || !corGeob(l, r->corp, &corp)) return 0;
+
+            Circulo c = criarCirculo(r->id, r->x, r->y, r->r, NULL, NULL, false, 0);
+            if (c != NULL) {
+                setIdCorbCirculo(c, corb);
+                setIdCorpCirculo(c, corp);
+            }
+            adicionaFormaChao(chao, criaForma(r->id, TIPO_CIRCULO, c));
+            return sizeof(RegistroCirculo);
+        }
+
+        case REGISTRO_RETANGULO: {
+            if (restante < sizeof(RegistroRetangulo)) return 0;
+            const RegistroRetangulo *r = (const RegistroRetangulo *)p;
+            IdCor corb, corp;
+            if (!corGeob(l, r->corb, &corb) || !corGeob(l, r->corp, &corp)) return 0;
+
+            Retangulo rt = criarRetangulo(r->id, r->x, r->y, r->w, r->h, NULL, NULL, false, 0);
+            if (rt != NULL) {
+                setIdCorbRetangulo(rt, corb);
+                setIdCorpRetangulo(rt, corp);
+            }
+            adicionaFormaChao(chao, criaForma(r->id, TIPO_RETANGULO, rt));
+            return sizeof(RegistroRetangulo);
+        }
+
+        case REGISTRO_LINHA: {
+            if (restante < sizeof(RegistroLinha)) return 0;
+            const RegistroLinha *r = (const RegistroLinha *)p;
+            IdCor cor;
+            if (!corGeob(l, r->cor, &cor)) return 0;
+
+            Linha ln = criarLinha(r->id, r->x1, r->y1, r->x2, r->y2, NULL, false, 0);
+            if (ln != NULL) {
+                setIdCorLinha(ln, cor);
+            }
+            adicionaFormaChao(chao, criaForma(r->id, TIPO_LINHA, ln));
+            return sizeof(RegistroLinha);
+        }
+
+        case REGISTRO_TEXTO: {
+            if (restante < sizeof(RegistroTexto)) return 0;
+            const RegistroTexto *r = (const RegistroTexto *)p;
+            IdCor corb, corp;
+            const char *conteudo = stringGeob(l, r->conteudo);
+            Estilo estilo = estiloGeob(l, r->estilo);
+            if (!corGeob(l, r->corb, &corb) || !corGeob(l, r->corp, &corp) ||
+                conteudo == NULL || estilo == NULL) {
+                return 0;
+            }
+
+            Texto t = criarTexto(r->id, r->x, r->y, NULL, NULL, r->ancora, conteudo, estilo);
+            setIdCorbTexto(t, corb);
+            setIdCorpTexto(t, corp);
+            adicionaFormaChao(chao, criaForma(r->id, TIPO_TEXTO, t));
+            return sizeof(RegistroTexto);
+        }
+    }
+    return 0;
+}
+
+Chao processaGeob(const char *nome_path_geob) {
+    int fd = open(nome_path_geob, O_RDONLY);
+    if (fd < 0) {
+        printf("Erro ao abrir o arquivo .geob: %s\n", nome_path_geob);
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+        printf("Erro: arquivo .geob inválido: %s\n", nome_path_geob);
+        close(fd);
+        return NULL;
+    }
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        printf("Erro ao abrir o arquivo .geob: %s\n", nome_path_geob);
+        return NULL;
+    }
+    //os registros são lidos uma vez, do início ao fim
+    posix_madvise(mapa, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+
+    LeituraGeob l;
+    memset(&l, 0, sizeof(l));
+    l.base = (const char *)mapa;
+    l.tamanho = (size_t)info.st_size;
+
+    if (!cabecalhoValido(&l)) {
+        printf("Erro: arquivo .geob inválido ou de outra versão: %s\n", nome_path_geob);
+        munmap(mapa, l.tamanho);
+        return NULL;
+    }
+
+    Chao meuChao = criaChao();
+    if (meuChao == NULL) {
+        printf("Erro ao criar o Chão!\n");
+        munmap(mapa, l.tamanho);
+        return NULL;
+    }
+
+    l.idsCores = (IdCor *)calloc((size_t)l.cab->numCores + 1, sizeof(IdCor));
+    l.estilos = (Estilo *)calloc((size_t)l.cab->numEstilos + 1, sizeof(Estilo));
+    if (l.idsCores == NULL || l.estilos == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+
+    const char *p = l.base + l.cab->inicioRegistros;
+    size_t restante = (size_t)l.cab->tamanhoRegistros;
+    uint64_t numFormas = 0;
+    bool valido = true;
+    while (restante > 0) {
+        size_t tam = leRegistroGeob(&l, p, restante, meuChao);
+        if (tam == 0) {
+            valido = false;
+            break;
+        }
+        p += tam;
+        restante -= tam;
+        numFormas++;
+    }
+    if (numFormas != l.cab->numFormas) {
+        valido = false;
+    }
+
+    //os textos guardam a sua própria referência aos dados do estilo
+    for (uint64_t k = 0; k < l.cab->numEstilos; k++) {
+        destroiEstilo(l.estilos[k]);
+    }
+    free(l.estilos);
+    free(l.idsCores);
+    munmap(mapa, l.tamanho);
+
+    if (!valido) {
+        printf("Erro: registro inválido no arquivo .geob: %s\n", nome_path_geob);
+        destroiChao(meuChao);
+        return NULL;
+    }
+    return meuChao;
+}
@@ -0,0 +1,62 @@
+#ifndef PROCESSAGEOB_H
+#define PROCESSAGEOB_H
+
+#include <stdbool.h>
+#include "chao.h"
+
+//       MÓDULO: CENA EM FORMATO BINÁRIO (.GEOB)
+
+/*      O .geob guarda as mesmas formas de um .geo já interpretadas, para que
+*       execuções repetidas sobre a mesma cena não precisem converter texto
+*       em números de novo. O arquivo é gerado a partir de um .geo pela
+*       ferramenta geo2geob (make geob) e lido com processaGeob.
+*
+*       Formato (versão 2, ordem de bytes da máquina que gravou):
+*        - cabeçalho fixo: assinatura "TEDGEOB", versão, marca de ordem de
+*          bytes, quantidade de formas por tipo e posição/tamanho das seções;
+*        - registros: um por forma, na ordem do Chão, sem preenchimento
+*          (círculo 37, retângulo 45, linha 41 e texto 38 bytes);
+*        - tabela de cores: uma por cor distinta, com o deslocamento do nome;
+*          os registros apontam para ela pelo índice (32 bits), e uma
+*          forma sem cor (COR_INDEFINIDA) grava o índice 0xFFFFFFFF;
+*        - tabela de estilos: um trio (família, peso, tamanho) por 'ts'
+*          distinto; os textos apontam para ela pelo índice;
+*        - tabela de strings: nomes de cores, conteúdos de texto e campos de
+*          estilo, cada string distinta uma vez só, terminada em '\0'; as
+*          referências são deslocamentos de 32 bits.
+*
+*       As coordenadas são gravadas como double (8 bytes, valor exato): em
+*       cenas com números de poucos dígitos o .geob pode ficar maior que o
+*       .geo; o formato prioriza a velocidade de leitura.
+*
+*       A leitura mapeia o arquivo (mmap) e cria cada forma direto dos campos
+*       do registro. Cada cor da tabela é internada uma vez só, na primeira
+*       forma que a usa; as outras recebem o IdCor pronto (setIdCor*). O
+*       conteúdo dos textos é copiado do mapeamento, como na leitura do .geo.
+*/
+
+/*________________________________ FUNÇÕES ________________________________*/
+
+/*
+Grava as formas do Chão em um arquivo .geob, na ordem em que estão.
+
+* chao: Chão recém-criado por processaGeo (formas como vieram do .geo)
+* caminho: arquivo .geob a ser criado
+*
+*       Pós-condição: retorna false se o arquivo não puder ser gravado
+*/
+bool escreveGeob(Chao chao, const char *caminho);
+
+/*
+Lê um arquivo .geob, criando todas as formas nele e as adicionando ao Chão,
+na mesma ordem e com os mesmos valores que processaGeo teria produzido
+a partir do .geo de origem.
+
+* nome_path_geob: caminho do arquivo .geob
+*
+*       Pós-condição: retorna o Chão com as formas, ou NULL se o arquivo não
+*       puder ser aberto ou não for um .geob válido desta versão
+*/
+Chao processaGeob(const char *nome_path_geob);
+
+#endif
@@ -1,6 +1,8 @@
 #include "processaQry.h"
 
 #include "fila.h"
+#include "tabelaHash.h"
+#include "gradeColisao.h"
 
 #include "carregador.h"
 #include "disparador.h"
@@ -13,94 +15,119 @@
 #include "linha.h"
 #include "texto.h"
 
+#include "relatorioTxt.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_OBJETOS 100
-
+//carregadores e disparadores indexados pelo id, sem limite de quantidade
 typedef struct stRepositorio {
-    Carregador carregadores[MAX_OBJETOS];
-    int num_carregadores;
-    Disparador disparadores[MAX_OBJETOS];
-    int num_disparadores;
+    TabelaHash carregadores;
+    TabelaHash disparadores;
 } RepositorioR;
 
 
 /*________________________________ FUNÇÕES AUXILIARES INTERNAS ________________________________*/
 
-static void imprimeDetalhesForma(Forma f, FILE *arquivo) {
-    if (f == NULL || arquivo == NULL) return;
-    
-    int id = getFormaId(f);
-    TipoForma tipo = getFormaTipo(f);
-    double x = getFormaX(f);
-    double y = getFormaY(f);
-    
-    fprintf(arquivo, "    Forma ID: %d, Tipo: ", id);
-    
-    switch (tipo) {
-        case TIPO_CIRCULO:
-            fprintf(arquivo, "Círculo, Centro: (%.2f, %.2f), Raio: %.2f, ", x, y, getRCirculo(getFormaAssoc(f)));           
-            fprintf(arquivo, "Borda: %s, Preench: %s\n", 
-                    getFormaCorBorda(f), getFormaCorPreenchimento(f));
-            break;
-            
-        case TIPO_RETANGULO:
-            fprintf(arquivo, "Retângulo, Posição: (%.2f, %.2f), ", x, y);
-            fprintf(arquivo, "Borda: %s, Preench: %s\n", 
-                    getFormaCorBorda(f), getFormaCorPreenchimento(f));
-            break;
-            
-        case TIPO_LINHA:
-            fprintf(arquivo, "Linha, Início: (%.2f, %.2f), ", x, y);
-            fprintf(arquivo, "Cor: %s\n", getFormaCorBorda(f));
-            break;
-            
-        case TIPO_TEXTO:
-            fprintf(arquivo, "Texto, Posição: (%.2f, %.2f), ", x, y);
-            fprintf(arquivo, "Borda: %s, Preench: %s\n", 
-                    getFormaCorBorda(f), getFormaCorPreenchimento(f));
-            break;
+// uma linha por forma, montada direto no bloco do relatório (as rajadas
+// relatam milhares de formas seguidas)
+static void imprimeDetalhesForma(Forma f, RelatorioTxt relatorio) {
+    if (f == NULL || relatorio == NULL) return;
+
+    escreveStrRelatorio(relatorio, "    Forma ID: ");
+    escreveInteiroRelatorio(relatorio, getFormaId(f));
+    escreveStrRelatorio(relatorio, ", Tipo: ");
+
+    const char *rotuloPosicao;
+    switch (getFormaTipo(f)) {
+        case TIPO_CIRCULO:   rotuloPosicao = "Círculo, Centro: (";    break;
+        case TIPO_RETANGULO: rotuloPosicao = "Retângulo, Posição: ("; break;
+        case TIPO_LINHA:     rotuloPosicao = "Linha, Início: (";      break;
+        case TIPO_TEXTO:     rotuloPosicao = "Texto, Posição: (";     break;
+        default: return;
+    }
+    escreveStrRelatorio(relatorio, rotuloPosicao);
+    escreveDecimalRelatorio(relatorio, getFormaX(f));
+    escreveStrRelatorio(relatorio, ", ");
+    escreveDecimalRelatorio(relatorio, getFormaY(f));
+    escreveStrRelatorio(relatorio, "), ");
+
+    if (getFormaTipo(f) == TIPO_CIRCULO) {
+        escreveStrRelatorio(relatorio, "Raio: ");
+        escreveDecimalRelatorio(relatorio, getRCirculo(getFormaAssoc(f)));
+        escreveStrRelatorio(relatorio, ", ");
+    }
+
+    if (getFormaTipo(f) == TIPO_LINHA) {
+        escreveStrRelatorio(relatorio, "Cor: ");
+        escreveStrRelatorio(relatorio, getFormaCorBorda(f));
+    } else {
+        escreveStrRelatorio(relatorio, "Borda: ");
+        escreveStrRelatorio(relatorio, getFormaCorBorda(f));
+        escreveStrRelatorio(relatorio, ", Preench: ");
+        escreveStrRelatorio(relatorio, getFormaCorPreenchimento(f));
     }
+    escreveStrRelatorio(relatorio, "\n");
+}
+
+// copia as formas da arena para um vetor, na ordem da fila
+typedef struct {
+    Forma *formas;
+    int n;
+} CopiaArena;
+
+static void copiaFormaArena(Forma f, void *auxData) {
+    CopiaArena *copia = (CopiaArena *)auxData;
+    copia->formas[copia->n++] = f;
+}
+
+static Disparador encontraDisparador(Repositorio *repo, int id) {
+    RepositorioR *repo_interno = (RepositorioR *)repo;
+    return (Disparador) buscaTabelaHash(repo_interno->disparadores, id);
 }
 
 static Disparador encontraOuCriaDisparador(Repositorio *repo, int id) {
     RepositorioR *repo_interno = (RepositorioR *)repo;
     
-    for (int i = 0; i < repo_interno->num_disparadores; i++) {
-        if (getDisparadorId(repo_interno->disparadores[i]) == id) {
-            return repo_interno->disparadores[i];
-        }
+    Disparador d = encontraDisparador(repo, id);
+    if (d != NULL) {
+        return d;
     }
     
-    if (repo_interno->num_disparadores < MAX_OBJETOS) {
-        Disparador novo = criaDisparador(id, 0.0, 0.0, NULL, NULL);
-        repo_interno->disparadores[repo_interno->num_disparadores] = novo;
-        repo_interno->num_disparadores++;
-        return novo;
+    Disparador novo = criaDisparador(id, 0.0, 0.0, NULL, NULL);
+    if (novo != NULL) {
+        insereTabelaHash(repo_interno->disparadores, id, novo);
     }
-    
-    return NULL;
+    return novo;
 }
 
 static Carregador encontraOuCriaCarregador(Repositorio *repo, int id) {
     RepositorioR *repo_interno = (RepositorioR *)repo;
 
-    for (int i = 0; i < repo_interno->num_carregadores; i++) {
-        if (getCarregadorId(repo_interno->carregadores[i]) == id) {
-            return repo_interno->carregadores[i];
-        }
+    Carregador c = (Carregador) buscaTabelaHash(repo_interno->carregadores, id);
+    if (c != NULL) {
+        return c;
     }
     
-    if (repo_interno->num_carregadores < MAX_OBJETOS) {
-        Carregador novo = criaCarregador(id);
-        repo_interno->carregadores[repo_interno->num_carregadores] = novo;
-        repo_interno->num_carregadores++;
-        return novo;
+    Carregador novo = criaCarregador(id);
+    if (novo != NULL) {
+        insereTabelaHash(repo_interno->carregadores, id, novo);
     }
-    
-    return NULL;
+    return novo;
+}
+
+// callbacks de destruição para iteraTabelaHash
+static void destroiCarregadorRepo(int id, void *valor, void *auxData) {
+    (void)id;
+    (void)auxData;
+    destroiCarregador(valor);
+}
+
+static void destroiDisparadorRepo(int id, void *valor, void *auxData) {
+    (void)id;
+    (void)auxData;
+    destroiDisparador(valor);
 }
 
 /*________________________________ FUNÇÕES PÚBLICAS ________________________________*/
@@ -112,8 +139,8 @@ Repositorio criaRepositorio() {
         return NULL;
     }
     
-    repo->num_carregadores = 0;
-    repo->num_disparadores = 0;
+    repo->carregadores = criaTabelaHash();
+    repo->disparadores = criaTabelaHash();
     
     return (Repositorio) repo;
 }
@@ -125,19 +152,17 @@ void destroiRepositorio(Repositorio repo) {
         return;
     }
     
-    for (int i = 0; i < repo_interno->num_carregadores; i++) {
-        destroiCarregador(repo_interno->carregadores[i]);
-    }
-    
-    for (int i = 0; i < repo_interno->num_disparadores; i++) {
-        destroiDisparador(repo_interno->disparadores[i]);
-    }
+    iteraTabelaHash(repo_interno->carregadores, destroiCarregadorRepo, NULL);
+    iteraTabelaHash(repo_interno->disparadores, destroiDisparadorRepo, NULL);
     
+    destroiTabelaHash(repo_interno->carregadores);
+    destroiTabelaHash(repo_interno->disparadores);
     free(repo_interno);
 }
 
 void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, Chao chao, 
-                 double *pontuacao_total, int *formas_clonadas_out, int *formas_esmagadas_out) {
+                 double *pontuacao_total, int *formas_clonadas_out, int *formas_esmagadas_out,
+                 NivelRelatorio nivel, EstatisticasQry estatisticas) {
     
     FILE *arquivo_qry = fopen(nome_path_qry, "r");
     if (arquivo_qry == NULL) {
@@ -145,8 +170,12 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
         return;
     }
     
-    FILE *arquivo_txt = fopen(nome_txt, "w");
-    if (arquivo_txt == NULL) {
+    //no nível "nenhum" o .txt não é criado
+    FILE *arquivo_txt = NULL;
+    if (nivel > RELATORIO_NENHUM) {
+        arquivo_txt = fopen(nome_txt, "w");
+    }
+    if (nivel > RELATORIO_NENHUM && arquivo_txt == NULL) {
         printf("Erro ao abrir o arquivo .txt: %s\n", nome_txt);
         fclose(arquivo_qry);
         return;
@@ -155,12 +184,14 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
     Repositorio repo = criaRepositorio();
     if (repo == NULL) {
         fclose(arquivo_qry);
-        fclose(arquivo_txt);
+        if (arquivo_txt != NULL) fclose(arquivo_txt);
         return;
     }
     
     //fila especial para anotações visuais (asteriscos, trajetórias, marcadores)
     Queue filaSVG = createQueue();
+    //estilo dos marcadores de disparo, compartilhado por todos eles
+    Estilo estilo_marcador = NULL;
     
     int instrucoes_realizadas = 0;
     int total_disparos = 0;
@@ -169,16 +200,36 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
     
     char linha_buffer[512];
     char comando[16];
+    int num_linha = 0;
     
-    fprintf(arquivo_txt, "_______ RELATÓRIO DE EXECUÇÃO ________ \n\n");
+    //relatório gravado por uma thread própria (relatorioTxt.h); o nível é
+    //testado antes de formatar qualquer linha
+    RelatorioTxt relatorio = NULL;
+    if (arquivo_txt != NULL) {
+        relatorio = criaRelatorioTxt(arquivo_txt, nivel);
+    }
+    bool relata_resumo = nivel >= RELATORIO_RESUMO;
+    bool relata_comandos = nivel >= RELATORIO_COMANDOS;
+    bool relata_detalhes = nivel >= RELATORIO_COMPLETO;
+
+    if (relata_resumo) {
+        escreveRelatorio(relatorio, "_______ RELATÓRIO DE EXECUÇÃO ________ \n\n");
+    }
     
     while (fgets(linha_buffer, sizeof(linha_buffer), arquivo_qry) != NULL) {
+        num_linha++;
         if (linha_buffer[0] == '\n' || linha_buffer[0] == '#') {
             continue;
         }
         
+        if (estatisticas != NULL) {
+            iniciaComandoQry(estatisticas);
+        }
         sscanf(linha_buffer, "%s", comando);
-        fprintf(arquivo_txt, "[*] %s", linha_buffer);
+        if (relata_comandos) {
+            escreveStrRelatorio(relatorio, "[*] ");
+            escreveStrRelatorio(relatorio, linha_buffer);
+        }
         
         //pd: posiciona disparador - pd l x y
         if (strcmp(comando, "pd") == 0) {
@@ -189,7 +240,9 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
             Disparador d = encontraOuCriaDisparador(repo, id);
             if (d != NULL) {
                 setDisparadorPosicao(d, x, y);
-                fprintf(arquivo_txt, " Disparador %d posicionado em (%.2f, %.2f)\n", id, x, y); 
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, " Disparador %d posicionado em (%.2f, %.2f)\n", id, x, y);
+                }
                 instrucoes_realizadas++;
             }
         }
@@ -201,14 +254,18 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
             
             Carregador c = encontraOuCriaCarregador(repo, id);
             if (c != NULL) {
-                fprintf(arquivo_txt, "    Carregando %d forma(s) no carregador %d:\n", n, id);
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Carregando %d forma(s) no carregador %d:\n", n, id);
+                }
                 
                 int formas_antes = getCarregadorTamanho(c);
                 carregaFormasDoChao(c, chao, n);
                 int formas_depois = getCarregadorTamanho(c);
                 int formas_carregadas = formas_depois - formas_antes;
                 
-                fprintf(arquivo_txt, "    Total de formas carregadas: %d\n", formas_carregadas);
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Total de formas carregadas: %d\n", formas_carregadas);
+                }
                 instrucoes_realizadas++;
             }
         }
@@ -222,34 +279,28 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
             Carregador dir = encontraOuCriaCarregador(repo, id_dir);
             
             if (esq == NULL || dir == NULL) {
-                fprintf(arquivo_txt, "    ERRO: Carregadores invalidos\n");
-                continue;
-            }
-            
-            RepositorioR *repo_interno = (RepositorioR *)repo;
-            Disparador d = NULL;
-            
-            for (int i = 0; i < repo_interno->num_disparadores; i++) {
-                if (getDisparadorId(repo_interno->disparadores[i]) == id_disp) {
-                    d = repo_interno->disparadores[i];
-                    break;
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    ERRO: Carregadores invalidos\n");
                 }
-            }
-            
-            if (d != NULL) {
-                reconectaCarregadores(d, esq, dir);
             } else {
-                d = criaDisparador(id_disp, 0.0, 0.0, esq, dir);
-                if (d != NULL && repo_interno->num_disparadores < MAX_OBJETOS) {
-                    repo_interno->disparadores[repo_interno->num_disparadores] = d;
-                    repo_interno->num_disparadores++;
+                Disparador d = encontraDisparador(repo, id_disp);
+                
+                if (d != NULL) {
+                    reconectaCarregadores(d, esq, dir);
+                } else {
+                    d = criaDisparador(id_disp, 0.0, 0.0, esq, dir);
+                    if (d != NULL) {
+                        insereTabelaHash(((RepositorioR *)repo)->disparadores, id_disp, d);
+                    }
+                }
+                
+                if (d != NULL) {
+                    if (relata_comandos) {
+                        escreveRelatorio(relatorio, "    Disparador %d conectado: carregador %d (esq) e %d (dir)\n", 
+                                id_disp, id_esq, id_dir);
+                    }
+                    instrucoes_realizadas++;
                 }
-            }
-            
-            if (d != NULL) {
-                fprintf(arquivo_txt, "    Disparador %d conectado: carregador %d (esq) e %d (dir)\n", 
-                        id_disp, id_esq, id_dir);
-                instrucoes_realizadas++;
             }
         }
         
@@ -264,11 +315,13 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
                 preparaDisparo(d, lado, n);
                 
                 Forma forma_pronta = getDisparadorFormaPronta(d);
-                if (forma_pronta != NULL) {
-                    fprintf(arquivo_txt, "    Forma pronta para disparo no disparador %d:\n", id);
-                    imprimeDetalhesForma(forma_pronta, arquivo_txt);
-                } else {
-                    fprintf(arquivo_txt, "    Nenhuma forma disponível no disparador %d\n", id);
+                if (relata_comandos && forma_pronta != NULL) {
+                    escreveRelatorio(relatorio, "    Forma pronta para disparo no disparador %d:\n", id);
+                    if (relata_detalhes) {
+                        imprimeDetalhesForma(forma_pronta, relatorio);
+                    }
+                } else if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Nenhuma forma disponível no disparador %d\n", id);
                 }
                 instrucoes_realizadas++;
             }
@@ -295,24 +348,31 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
                     double x_final = getFormaX(forma_disparada);
                     double y_final = getFormaY(forma_disparada);
                     
-                    fprintf(arquivo_txt, "    Forma disparada:\n");
-                    imprimeDetalhesForma(forma_disparada, arquivo_txt);
-                    fprintf(arquivo_txt, "    Posição inicial disparador: (%.2f, %.2f)\n", x_disp, y_disp);
-                    fprintf(arquivo_txt, "    Posição final forma: (%.2f, %.2f)\n", x_final, y_final);
+                    if (relata_comandos) {
+                        escreveRelatorio(relatorio, "    Forma disparada:\n");
+                        if (relata_detalhes) {
+                            imprimeDetalhesForma(forma_disparada, relatorio);
+                        }
+                        escreveRelatorio(relatorio, "    Posição inicial disparador: (%.2f, %.2f)\n", x_disp, y_disp);
+                        escreveRelatorio(relatorio, "    Posição final forma: (%.2f, %.2f)\n", x_final, y_final);
+                    }
                     
                     insereFormaArena(arena, forma_disparada);
                     
                     //tratamento da flag "v" - criar anotações visuais
                     if (num_params == 4 && strcmp(flag, "v") == 0) {
-                        fprintf(arquivo_txt, "    [Flag visual 'v' ativada]\n");
+                        if (relata_comandos) {
+                            escreveRelatorio(relatorio, "    [Flag visual 'v' ativada]\n");
+                        }
                         
                         //marcador do disparador (número vermelho)
                         char id_str[16];
                         sprintf(id_str, "%d", id);
-                        Estilo estilo_marcador = criarEstilo("sans-serif", "bold", "16px");
+                        if (estilo_marcador == NULL) {
+                            estilo_marcador = criarEstilo("sans-serif", "bold", "16px");
+                        }
                         Texto texto_id = criarTexto(-1000 - id, x_disp, y_disp, 
                                                     "red", "red", 'm', id_str, estilo_marcador);
-                        destroiEstilo(estilo_marcador);
                         Forma forma_marcador = criaForma(-1000 - id, TIPO_TEXTO, texto_id);
                         enfileira(filaSVG, forma_marcador);
                         
@@ -336,12 +396,14 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
                         Forma forma_proj_x = criaForma(-3000 - total_disparos, TIPO_LINHA, proj_x);
                         enfileira(filaSVG, forma_proj_x);
                         
-                        fprintf(arquivo_txt, "      Anotações visuais criadas\n");
+                        if (relata_comandos) {
+                            escreveRelatorio(relatorio, "      Anotações visuais criadas\n");
+                        }
                     }
                     
                     instrucoes_realizadas++;
-                } else {
-                    fprintf(arquivo_txt, "    Falha: Nenhuma forma na posição de disparo\n");
+                } else if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Falha: Nenhuma forma na posição de disparo\n");
                 }
             }
         }
@@ -356,50 +418,80 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
             
             Disparador d = encontraOuCriaDisparador(repo, id);
             if (d != NULL) {
-                fprintf(arquivo_txt, "    Iniciando rajada de disparos no disparador %d (lado %c):\n", id, lado);
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Iniciando rajada de disparos no disparador %d (lado %c):\n", id, lado);
+                }
                 
+                //a rajada inteira sai do carregador de uma vez (disparador.h)
                 int disparos_rajada = 0;
-                int i = 0;
-                
-                while (true) {
-                    preparaDisparo(d, lado, 1);
-                    
-                    Forma forma_pronta = getDisparadorFormaPronta(d);
-                    if (forma_pronta == NULL) {
-                        break;
-                    }
-                    
-                    double dx_atual = dx + i * ix;
-                    double dy_atual = dy + i * iy;
-                    
-                    Forma forma_disparada = dispara(d, dx_atual, dy_atual);
-                    
-                    if (forma_disparada != NULL) {
-                        total_disparos++;
-                        disparos_rajada++;
-                        
-                        fprintf(arquivo_txt, "      Disparo %d: deslocamento (%.2f, %.2f)\n", 
-                                disparos_rajada, dx_atual, dy_atual);
-                        imprimeDetalhesForma(forma_disparada, arquivo_txt);
-                        
-                        insereFormaArena(arena, forma_disparada);
+                Forma *rajada = disparaRajada(d, lado, dx, dy, ix, iy, &disparos_rajada);
+
+                if (disparos_rajada > 0) {
+                    for (int i = 0; relata_detalhes && i < disparos_rajada; i++) {
+                        escreveStrRelatorio(relatorio, "      Disparo ");
+                        escreveInteiroRelatorio(relatorio, i + 1);
+                        escreveStrRelatorio(relatorio, ": deslocamento (");
+                        escreveDecimalRelatorio(relatorio, dx + i * ix);
+                        escreveStrRelatorio(relatorio, ", ");
+                        escreveDecimalRelatorio(relatorio, dy + i * iy);
+                        escreveStrRelatorio(relatorio, ")\n");
+                        imprimeDetalhesForma(rajada[i], relatorio);
                     }
-                    
-                    i++;
+
+                    insereFormasArena(arena, rajada, disparos_rajada);
+                    total_disparos += disparos_rajada;
                 }
+                free(rajada);
                 
-                fprintf(arquivo_txt, "    Total de disparos na rajada: %d\n", disparos_rajada);
+                if (relata_comandos) {
+                    escreveRelatorio(relatorio, "    Total de disparos na rajada: %d\n", disparos_rajada);
+                }
                 instrucoes_realizadas++;
             }
         }
         
+        //sbp: todos os pares sobrepostos na arena (grade uniforme, gradeColisao.h);
+        //só relata, então abaixo do nível "comandos" nem calcula os pares
+        else if (strcmp(comando, "sbp") == 0 && !relata_comandos) {
+            instrucoes_realizadas++;
+        }
+        else if (strcmp(comando, "sbp") == 0) {
+            int num_formas = getArenaNumFormas(arena);
+            CopiaArena copia;
+            copia.formas = (Forma *)malloc((num_formas > 0 ? num_formas : 1) * sizeof(Forma));
+            if (copia.formas == NULL) {
+                printf("Erro ao alocar memoria para o sbp!\n");
+                exit(1);
+            }
+            copia.n = 0;
+            iteraFormasArena(arena, copiaFormaArena, &copia);
+
+            int *pares = NULL;
+            int num_pares = calculaParesSobrepostos(copia.formas, copia.n, &pares);
+
+            escreveRelatorio(relatorio, "    Pares sobrepostos na arena (%d formas):\n", copia.n);
+            for (int k = 0; relata_detalhes && k < num_pares; k++) {
+                escreveRelatorio(relatorio, "      Forma %d x Forma %d\n",
+                        getFormaId(copia.formas[pares[2 * k]]), getFormaId(copia.formas[pares[2 * k + 1]]));
+            }
+            escreveRelatorio(relatorio, "    Total de pares sobrepostos: %d\n", num_pares);
+
+            free(pares);
+            free(copia.formas);
+            instrucoes_realizadas++;
+        }
+        
         //calc: Calcular colisões e processar arena
         else if (strcmp(comando, "calc") == 0) {
             instrucoes_realizadas++;
             
-            processaInteracoesArena(arena, chao, pontuacao_total, filaSVG, arquivo_txt, 
+            processaInteracoesArena(arena, chao, pontuacao_total, filaSVG, relatorio, 
                                    &formas_clonadas, &formas_esmagadas, repo);
         }
+        
+        if (estatisticas != NULL) {
+            encerraComandoQry(estatisticas, comando, num_linha, linha_buffer);
+        }
     }
     
     //ao final, adicionar todas as anotações visuais ao chão para serem desenhadas
@@ -409,19 +501,23 @@ void processaQry(const char *nome_path_qry, const char *nome_txt, Arena arena, C
     }
     
     //relatório final
-    fprintf(arquivo_txt, "\n===== RELATÓRIO FINAL =====\n");
-    fprintf(arquivo_txt, "Pontuação total: %.2f\n", *pontuacao_total);
-    fprintf(arquivo_txt, "Número de instruções realizadas: %d\n", instrucoes_realizadas);
-    fprintf(arquivo_txt, "Número total de disparos: %d\n", total_disparos);
-    fprintf(arquivo_txt, "Número de formas esmagadas: %d\n", formas_esmagadas);
-    fprintf(arquivo_txt, "Número de formas clonadas: %d\n", formas_clonadas);
-    fprintf(arquivo_txt, "===============================\n");
+    if (relata_resumo) {
+        escreveRelatorio(relatorio, "\n===== RELATÓRIO FINAL =====\n");
+        escreveRelatorio(relatorio, "Pontuação total: %.2f\n", *pontuacao_total);
+        escreveRelatorio(relatorio, "Número de instruções realizadas: %d\n", instrucoes_realizadas);
+        escreveRelatorio(relatorio, "Número total de disparos: %d\n", total_disparos);
+        escreveRelatorio(relatorio, "Número de formas esmagadas: %d\n", formas_esmagadas);
+        escreveRelatorio(relatorio, "Número de formas clonadas: %d\n", formas_clonadas);
+        escreveRelatorio(relatorio, "===============================\n");
+    }
     
     if (formas_clonadas_out != NULL) *formas_clonadas_out = formas_clonadas;
     if (formas_esmagadas_out != NULL) *formas_esmagadas_out = formas_esmagadas;
     
+    destroiEstilo(estilo_marcador);
     destroiFila(filaSVG);
     destroiRepositorio(repo);
     fclose(arquivo_qry);
-    fclose(arquivo_txt);
+    fechaRelatorioTxt(relatorio);
+    if (arquivo_txt != NULL) fclose(arquivo_txt);
 }
\ No newline at end of file
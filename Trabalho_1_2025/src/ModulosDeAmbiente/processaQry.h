@@ -5,12 +5,15 @@
 #include "disparador.h"
 #include "carregador.h"
 #include "arena.h"
+#include "relatorioTxt.h"
+#include "estatisticasQry.h"
 
 /*_______________________ TIPO ABSTRATO DE DADOS: REPOSITÓRIO _______________________*/
 /*
  * O Repositório é uma estrutura que centraliza o gerenciamento de todos os
  * Carregadores e Disparadores do sistema, permitindo acesso e manipulação
  * eficientes durante o processamento de comandos do arquivo .qry.
+ * Cada tipo fica em uma TabelaHash indexada pelo id, sem limite de quantidade.
  */
 
 typedef void *Repositorio;
@@ -55,6 +58,11 @@ void destroiRepositorio(Repositorio repo);
  * pontuacao_total: Ponteiro para a variável que acumula a pontuação total.
  * formas_clonadas: Ponteiro para a variável que acumula a quantidade de formas clonadas.
  * formas_esmagadas: Ponteiro para a variável que acumula a quantidade de formas esmagadas.
+ * nivel: Quanto o .txt registra (relatorioTxt.h). RELATORIO_COMPLETO é o relatório
+ *        de sempre; RELATORIO_RESUMO só traz o relatório final; RELATORIO_NENHUM
+ *        não cria o .txt. Os comandos são executados igualmente em todos os níveis.
+ * estatisticas: Se não for NULL, recebe o tempo de cada comando executado
+ *               (estatisticasQry.h); com NULL o relógio não é consultado.
  * 
  * Pré-condição: 'nome_path_qry', 'nome_txt', 'arena' e 'chao' devem ser válidos;
  *               'pontuacao_total' deve ser um ponteiro para uma variável double inicializada.
@@ -62,8 +70,11 @@ void destroiRepositorio(Repositorio repo);
  *                int inicializada.
  * Pós-condição: Os comandos do arquivo .qry são executados, os relatórios são
  *               gerados no arquivo .txt, e a pontuação total é atualizada.
+ *
+ * Além dos comandos de jogo, 'sbp' (sem parâmetros) lista no .txt todos os
+ * pares de formas da Arena que se sobrepõem, sem alterar a Arena.
  */
-void processaQry(const char *nome_path_qry, const char *nome_txt,  Arena arena, Chao chao, double *pontuacao_total, int *formas_clonadas, int *formas_esmagadas);
+void processaQry(const char *nome_path_qry, const char *nome_txt,  Arena arena, Chao chao, double *pontuacao_total, int *formas_clonadas, int *formas_esmagadas, NivelRelatorio nivel, EstatisticasQry estatisticas);
 
 
 
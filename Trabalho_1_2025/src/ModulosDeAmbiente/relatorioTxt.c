@@ -0,0 +1,314 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "relatorioTxt.h"
+#include "formataNumero.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+
+// bloco em que a thread produtora formata o texto antes de publicá-lo (64 KiB)
+#define TAMANHO_BLOCO_RELATORIO (1 << 16)
+
+// capacidade do anel entre as threads (8 MiB, potência de 2)
+#define TAMANHO_ANEL_RELATORIO (1 << 23)
+
+// buffer do FILE* do relatório, para a thread escritora gravar em poucas chamadas (1 MiB)
+#define TAMANHO_BUFFER_ARQUIVO (1 << 20)
+
+typedef struct {
+    FILE *arquivo;
+    NivelRelatorio nivel;
+
+    // anel: cabeca e cauda só crescem; a posição no vetor é o valor módulo
+    // TAMANHO_ANEL_RELATORIO. A produtora só escreve cabeca e a escritora
+    // só escreve cauda, então os dados não precisam de trava.
+    char *anel;
+    size_t cabeca;
+    size_t cauda;
+
+    // espera das threads quando o anel está vazio (escritora) ou cheio (produtora)
+    pthread_mutex_t trava;
+    pthread_cond_t sinal;
+    int escritoraEsperando;
+    int produtoraEsperando;
+    int encerrar;
+
+    pthread_t escritora;
+    bool sincrono;
+
+    size_t usado;
+    char bloco[TAMANHO_BLOCO_RELATORIO];
+} RelatorioTxtC;
+
+
+/*________________________________ SINCRONIZAÇÃO ________________________________*/
+
+/*
+Acorda a outra thread se ela avisou que está esperando. Chamada logo depois
+de publicar cabeca ou cauda: a barreira impede que a leitura do aviso seja
+feita antes dessa publicação ficar visível (ver esperaEnquanto).
+*/
+static void acordaSeEsperando(RelatorioTxtC *rel, int *esperando) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(esperando, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&rel->trava);
+        pthread_cond_broadcast(&rel->sinal);
+        pthread_mutex_unlock(&rel->trava);
+    }
+}
+
+/*
+Espera, sem prazo, até a outra thread sinalizar uma mudança em 'condicao'.
+O aviso em 'esperando' é publicado e seguido de uma barreira antes de
+reconferir a condição; do outro lado, acordaSeEsperando publica a mudança,
+passa por uma barreira e só então lê o aviso. Com as duas barreiras ao menos
+uma das threads enxerga a outra: ou esta vê a mudança e não dorme, ou a
+outra vê o aviso e sinaliza. O sinal é dado com a trava, que esta thread só
+solta dentro de pthread_cond_wait, então ele não se perde. O chamador
+reconfere o anel ao voltar (cobre acordadas espúrias).
+*/
+static void esperaEnquanto(RelatorioTxtC *rel, int *esperando,
+                           bool (*condicao)(RelatorioTxtC*)) {
+    pthread_mutex_lock(&rel->trava);
+    __atomic_store_n(esperando, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (condicao(rel)) {
+        pthread_cond_wait(&rel->sinal, &rel->trava);
+    }
+    __atomic_store_n(esperando, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&rel->trava);
+}
+
+static bool anelVazioSemEncerrar(RelatorioTxtC *rel) {
+    return __atomic_load_n(&rel->cabeca, __ATOMIC_SEQ_CST) == rel->cauda &&
+           !__atomic_load_n(&rel->encerrar, __ATOMIC_SEQ_CST);
+}
+
+static bool anelCheio(RelatorioTxtC *rel) {
+    return rel->cabeca - __atomic_load_n(&rel->cauda, __ATOMIC_SEQ_CST) == TAMANHO_ANEL_RELATORIO;
+}
+
+
+/*________________________________ THREAD ESCRITORA ________________________________*/
+
+static void *threadEscritora(void *arg) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) arg;
+
+    while (true) {
+        // encerrar é lido antes de cabeca: se estava marcado, cabeca já tem
+        // tudo o que a produtora publicou
+        int encerrar = __atomic_load_n(&rel->encerrar, __ATOMIC_ACQUIRE);
+        size_t cabeca = __atomic_load_n(&rel->cabeca, __ATOMIC_ACQUIRE);
+
+        if (cabeca == rel->cauda) {
+            if (encerrar) {
+                break;
+            }
+            esperaEnquanto(rel, &rel->escritoraEsperando, anelVazioSemEncerrar);
+            continue;
+        }
+
+        // grava até o fim do vetor; a volta fica para a próxima iteração
+        size_t inicio = rel->cauda & (TAMANHO_ANEL_RELATORIO - 1);
+        size_t quantidade = cabeca - rel->cauda;
+        if (quantidade > TAMANHO_ANEL_RELATORIO - inicio) {
+            quantidade = TAMANHO_ANEL_RELATORIO - inicio;
+        }
+        fwrite(rel->anel + inicio, 1, quantidade, rel->arquivo);
+
+        __atomic_store_n(&rel->cauda, rel->cauda + quantidade, __ATOMIC_RELEASE);
+        acordaSeEsperando(rel, &rel->produtoraEsperando);
+    }
+    return NULL;
+}
+
+
+/*________________________________ PUBLICAÇÃO ________________________________*/
+
+// entrega 'tamanho' bytes à thread escritora (ou ao arquivo, se síncrono)
+static void publicaRelatorio(RelatorioTxtC *rel, const char *dados, size_t tamanho) {
+    if (rel->sincrono) {
+        fwrite(dados, 1, tamanho, rel->arquivo);
+        return;
+    }
+
+    while (tamanho > 0) {
+        size_t cauda = __atomic_load_n(&rel->cauda, __ATOMIC_ACQUIRE);
+        size_t livre = TAMANHO_ANEL_RELATORIO - (rel->cabeca - cauda);
+        if (livre == 0) {
+            esperaEnquanto(rel, &rel->produtoraEsperando, anelCheio);
+            continue;
+        }
+
+        size_t quantidade = (tamanho < livre) ? tamanho : livre;
+        size_t inicio = rel->cabeca & (TAMANHO_ANEL_RELATORIO - 1);
+        size_t primeiro = TAMANHO_ANEL_RELATORIO - inicio;
+        if (primeiro > quantidade) {
+            primeiro = quantidade;
+        }
+        memcpy(rel->anel + inicio, dados, primeiro);
+        memcpy(rel->anel, dados + primeiro, quantidade - primeiro);
+
+        __atomic_store_n(&rel->cabeca, rel->cabeca + quantidade, __ATOMIC_RELEASE);
+        acordaSeEsperando(rel, &rel->escritoraEsperando);
+
+        dados += quantidade;
+        tamanho -= quantidade;
+    }
+}
+
+static void descarregaBlocoRelatorio(RelatorioTxtC *rel) {
+    if (rel->usado > 0) {
+        publicaRelatorio(rel, rel->bloco, rel->usado);
+        rel->usado = 0;
+    }
+}
+
+// garante 'tamanho' bytes livres no bloco (tamanho <= TAMANHO_BLOCO_RELATORIO)
+static char *reservaRelatorio(RelatorioTxtC *rel, size_t tamanho) {
+    if (TAMANHO_BLOCO_RELATORIO - rel->usado < tamanho) {
+        descarregaBlocoRelatorio(rel);
+    }
+    return rel->bloco + rel->usado;
+}
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+RelatorioTxt criaRelatorioTxt(FILE *arquivo, NivelRelatorio nivel) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) malloc(sizeof(RelatorioTxtC));
+    if (rel == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    rel->arquivo = arquivo;
+    rel->nivel = nivel;
+    rel->usado = 0;
+    rel->cabeca = 0;
+    rel->cauda = 0;
+    rel->escritoraEsperando = 0;
+    rel->produtoraEsperando = 0;
+    rel->encerrar = 0;
+    rel->sincrono = false;
+
+    // antes de qualquer escrita no arquivo, como setvbuf exige
+    setvbuf(arquivo, NULL, _IOFBF, TAMANHO_BUFFER_ARQUIVO);
+
+    rel->anel = (char*) malloc(TAMANHO_ANEL_RELATORIO);
+    if (rel->anel == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    pthread_mutex_init(&rel->trava, NULL);
+    pthread_cond_init(&rel->sinal, NULL);
+
+    // sem a thread, o relatório continua correto gravando direto no arquivo
+    if (pthread_create(&rel->escritora, NULL, threadEscritora, rel) != 0) {
+        rel->sincrono = true;
+    }
+    return (RelatorioTxt) rel;
+}
+
+void fechaRelatorioTxt(RelatorioTxt r) {
+    if (r == NULL) {
+        return;
+    }
+    RelatorioTxtC *rel = (RelatorioTxtC*) r;
+    descarregaBlocoRelatorio(rel);
+
+    if (!rel->sincrono) {
+        __atomic_store_n(&rel->encerrar, 1, __ATOMIC_RELEASE);
+        pthread_mutex_lock(&rel->trava);
+        pthread_cond_broadcast(&rel->sinal);
+        pthread_mutex_unlock(&rel->trava);
+        pthread_join(rel->escritora, NULL);
+    }
+    fflush(rel->arquivo);
+
+    pthread_cond_destroy(&rel->sinal);
+    pthread_mutex_destroy(&rel->trava);
+    free(rel->anel);
+    free(rel);
+}
+
+NivelRelatorio getNivelRelatorioTxt(RelatorioTxt r) {
+    if (r == NULL) {
+        return RELATORIO_NENHUM;
+    }
+    return ((RelatorioTxtC*) r)->nivel;
+}
+
+/*________________________________ FUNÇÕES DE ESCRITA ________________________________*/
+
+void escreveRelatorio(RelatorioTxt r, const char *formato, ...) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) r;
+    va_list args;
+
+    // primeira tentativa no espaço que sobra do bloco
+    size_t livre = TAMANHO_BLOCO_RELATORIO - rel->usado;
+    va_start(args, formato);
+    int n = vsnprintf(rel->bloco + rel->usado, livre, formato, args);
+    va_end(args);
+    if (n < 0) {
+        return;
+    }
+    if ((size_t) n < livre) {
+        rel->usado += (size_t) n;
+        return;
+    }
+
+    // não coube: esvazia o bloco e formata de novo
+    descarregaBlocoRelatorio(rel);
+    if ((size_t) n < TAMANHO_BLOCO_RELATORIO) {
+        va_start(args, formato);
+        vsnprintf(rel->bloco, TAMANHO_BLOCO_RELATORIO, formato, args);
+        va_end(args);
+        rel->usado = (size_t) n;
+        return;
+    }
+
+    // maior que o bloco inteiro: formata em um buffer próprio
+    char *temporario = (char*) malloc((size_t) n + 1);
+    if (temporario == NULL) {
+        printf("Erro: falha na alocação de memória.\n");
+        exit(1);
+    }
+    va_start(args, formato);
+    vsnprintf(temporario, (size_t) n + 1, formato, args);
+    va_end(args);
+    publicaRelatorio(rel, temporario, (size_t) n);
+    free(temporario);
+}
+
+void escreveBytesRelatorio(RelatorioTxt r, const char *dados, size_t tamanho) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) r;
+    if (tamanho > TAMANHO_BLOCO_RELATORIO) {
+        descarregaBlocoRelatorio(rel);
+        publicaRelatorio(rel, dados, tamanho);
+        return;
+    }
+    char *destino = reservaRelatorio(rel, tamanho);
+    memcpy(destino, dados, tamanho);
+    rel->usado += tamanho;
+}
+
+void escreveStrRelatorio(RelatorioTxt r, const char *s) {
+    escreveBytesRelatorio(r, s, strlen(s));
+}
+
+void escreveInteiroRelatorio(RelatorioTxt r, long valor) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) r;
+    char *destino = reservaRelatorio(rel, TAMANHO_MAX_INTEIRO);
+    rel->usado += (size_t) formataInteiro(destino, valor);
+}
+
+void escreveDecimalRelatorio(RelatorioTxt r, double valor) {
+    RelatorioTxtC *rel = (RelatorioTxtC*) r;
+    char *destino = reservaRelatorio(rel, TAMANHO_MAX_DECIMAL);
+    rel->usado += (size_t) formataDecimal2(destino, valor);
+}
@@ -0,0 +1,87 @@
+#ifndef RELATORIOTXT_H
+#define RELATORIOTXT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/*
+*        TIPO ABSTRATO DE DADOS: RELATÓRIO TXT ASSÍNCRONO
+*
+*        Saída do relatório de execução (.txt) fora da thread principal.
+*        O texto é formatado pela thread que processa os comandos em um
+*        bloco local; blocos cheios são copiados para um anel circular
+*        (um produtor e um consumidor, sem trava no caminho dos dados) e
+*        uma thread escritora os grava no arquivo. A thread principal só
+*        espera se o anel inteiro estiver cheio.
+*
+*        O conteúdo e a ordem dos bytes são exatamente os de escrever com
+*        fprintf direto no arquivo. Se a thread escritora não puder ser
+*        criada, o relatório grava de forma síncrona, com o mesmo resultado.
+*
+*        Um relatório deve ser usado por uma única thread produtora.
+*/
+
+typedef void *RelatorioTxt;
+
+/*
+Quanto o relatório registra. Cada nível inclui os anteriores. Quem escreve
+consulta o nível antes de formatar qualquer coisa, então o que fica de fora
+não custa nada além do teste.
+*/
+typedef enum {
+    RELATORIO_NENHUM = 0,     // nenhum relatório (o .txt nem é criado)
+    RELATORIO_RESUMO = 1,     // só os totais do relatório final
+    RELATORIO_COMANDOS = 2,   // cada comando e os totais dele
+    RELATORIO_COMPLETO = 3    // cada forma, disparo e par (padrão)
+} NivelRelatorio;
+
+
+/*________________________________ FUNÇÕES DE CRIAÇÃO E DESTRUIÇÃO ________________________________*/
+
+/*
+Cria o relatório e a thread escritora.
+
+* arquivo: FILE* aberto para escrita
+* nivel: nível de detalhe registrado (consultado com getNivelRelatorioTxt)
+*
+* Pré-condição: arquivo deve ser válido, ainda sem nada lido ou escrito
+* (o relatório troca o buffer dele por um de 1 MiB com setvbuf), e não deve
+* ser usado diretamente enquanto o relatório existir
+* Pós-condição: retorna o relatório, ou o programa é encerrado em caso de
+* falha de alocação. O relatório não fecha o arquivo.
+*/
+RelatorioTxt criaRelatorioTxt(FILE *arquivo, NivelRelatorio nivel);
+
+/*
+Espera todo o texto pendente chegar ao arquivo, encerra a thread escritora
+e libera o relatório (o arquivo continua aberto).
+*/
+void fechaRelatorioTxt(RelatorioTxt r);
+
+// Retorna o nível do relatório (RELATORIO_NENHUM se r for NULL)
+NivelRelatorio getNivelRelatorioTxt(RelatorioTxt r);
+
+
+/*________________________________ FUNÇÕES DE ESCRITA ________________________________*/
+/*
+* r: relatório de destino
+* Pré-condição: r deve ser um relatório válido
+*/
+
+// Escreve como fprintf(arquivo, formato, ...)
+void escreveRelatorio(RelatorioTxt r, const char *formato, ...)
+    __attribute__((format(printf, 2, 3)));
+
+// Escreve 'tamanho' bytes de 'dados'
+void escreveBytesRelatorio(RelatorioTxt r, const char *dados, size_t tamanho);
+
+// Escreve uma string terminada em '\0'
+void escreveStrRelatorio(RelatorioTxt r, const char *s);
+
+// Escreve 'valor' exatamente como printf("%ld", valor)
+void escreveInteiroRelatorio(RelatorioTxt r, long valor);
+
+// Escreve 'valor' exatamente como printf("%.2f", valor)
+void escreveDecimalRelatorio(RelatorioTxt r, double valor);
+
+#endif
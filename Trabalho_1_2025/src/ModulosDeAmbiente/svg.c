@@ -1,18 +1,23 @@
 #include "svg.h"
 #include "fila.h"
 #include "formas.h"
+#include "formataNumero.h"
 
 #include <stdio.h>
 
-FILE* inicializaSvg(char *caminho, double largura, double altura) {
-    FILE *svg = fopen(caminho, "w");
-    if (svg == NULL) {
+EscritorSvg inicializaSvg(char *caminho, double largura, double altura) {
+    FILE *arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
         perror("Erro ao abrir arquivo SVG");
         return NULL;
     }
+    EscritorSvg svg = criaEscritorSvg(arquivo);
 
-    // SVG com viewBox
-    fprintf(svg, "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 %.0f %.0f\">\n", largura, altura);
+    // SVG com viewBox (uma vez por arquivo, então o snprintf basta)
+    char cabecalho[TAMANHO_MAX_DECIMAL * 2 + 96];
+    int tamanho = snprintf(cabecalho, sizeof(cabecalho),
+                           "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 %.0f %.0f\">\n", largura, altura);
+    escreveBytesSvg(svg, cabecalho, (size_t)tamanho);
     
     //fundo cinza claro, tirei pra ver com o gabarito
     //fprintf(svg, "\t<rect width=\"100%%\" height=\"100%%\" fill=\"#f0f0f0\" />\n");
@@ -20,9 +25,11 @@ FILE* inicializaSvg(char *caminho, double largura, double altura) {
     return svg;
 }
 
-void fechaSvg(FILE *svg) {
+void fechaSvg(EscritorSvg svg) {
     if (svg == NULL) return;
     
-    fprintf(svg, "\n</svg>");
-    fclose(svg);
+    FILE *arquivo = getArquivoEscritorSvg(svg);
+    escreveStrSvg(svg, "\n</svg>");
+    destroiEscritorSvg(svg);
+    fclose(arquivo);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define SVG_H
 
 #include <stdio.h>
+#include "escritorSvg.h"
 #include "retangulo.h"
 #include "circulo.h"
 #include "linha.h"
@@ -42,25 +43,26 @@ de desenho visível.
 *        altura: altura da área de visualização do SVG (coordenada máxima Y)
 *
 *        Pré-condição: caminho deve ser válido, largura e altura > 0
-*        Pós-condição: retorna ponteiro FILE* aberto para escrita com cabeçalho SVG,
+*        Pós-condição: retorna um EscritorSvg (escritorSvg.h) sobre o arquivo aberto,
+*                      com o cabeçalho SVG já escrito no buffer,
 *                      ou NULL se houver erro na abertura do arquivo
 */
-FILE* inicializaSvg(char *caminho, double largura, double altura);
+EscritorSvg inicializaSvg(char *caminho, double largura, double altura);
 
 /*
 Finaliza e fecha o arquivo SVG.
 
-Esta função escreve a tag de fechamento </svg> e fecha o arquivo,
-garantindo que todo o conteúdo seja salvo corretamente no disco.
-Deve ser chamada ao final de todas as operações de desenho.
+Esta função escreve a tag de fechamento </svg>, descarrega o buffer do
+escritor e fecha o arquivo, garantindo que todo o conteúdo seja salvo
+corretamente no disco. Deve ser chamada ao final de todas as operações de desenho.
 
-*        svg: ponteiro para o arquivo SVG aberto
+*        svg: escritor retornado por inicializaSvg
 *
-*        Pré-condição: svg deve ser um ponteiro FILE* válido
+*        Pré-condição: svg deve ser um escritor válido
 *        Pós-condição: arquivo SVG fechado com tag de fechamento escrita,
 *                      se svg for NULL a função não faz nada
 */
-void fechaSvg(FILE *svg);
+void fechaSvg(EscritorSvg svg);
 
 
 /*                    FUNÇÕES DE INSERÇÃO DE FORMAS                    */
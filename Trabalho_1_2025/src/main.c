@@ -11,10 +11,14 @@
 #include "chao.h"         
 
 #include "formas.h"    
+#include "memoriaFormas.h"
+#include "cores.h"
 
 #include "svg.h"      
 #include "processaGeo.h" 
+#include "processaGeob.h"
 #include "processaQry.h"  
+#include "perfil.h"
 
 
 //makefile com padrão C99.
@@ -58,6 +62,26 @@ static char* montaCaminhoCompleto(const char *dir, const char *nomeArquivo) {
 }
 
 
+//nível do -v pelo nome (inglês ou português) ou pelo número 0 a 3.
+static bool trataNivelRelatorio(const char *arg, NivelRelatorio *nivel) {
+    static const struct { const char *nome; const char *nomePt; NivelRelatorio nivel; } niveis[] = {
+        { "none",     "nenhum",   RELATORIO_NENHUM },
+        { "summary",  "resumo",   RELATORIO_RESUMO },
+        { "commands", "comandos", RELATORIO_COMANDOS },
+        { "full",     "completo", RELATORIO_COMPLETO }
+    };
+
+    for (int k = 0; k < 4; k++) {
+        if (strcmp(arg, niveis[k].nome) == 0 || strcmp(arg, niveis[k].nomePt) == 0 ||
+            (arg[0] == '0' + k && arg[1] == '\0')) {
+            *nivel = niveis[k].nivel;
+            return true;
+        }
+    }
+    return false;
+}
+
+
 //tira geo ou .qry para obter o nome base do arquivo.
 
 static void getNomeBase(const char *nomeCompleto, char *destino, int tamMax) {
@@ -69,31 +93,30 @@ static void getNomeBase(const char *nomeCompleto, char *destino, int tamMax) {
     }
 }
 
+// true se o nome termina com a extensão dada (ex: ".geob")
+static bool temExtensao(const char *nome, const char *extensao) {
+    size_t tamNome = strlen(nome);
+    size_t tamExtensao = strlen(extensao);
+    return tamNome >= tamExtensao && strcmp(nome + tamNome - tamExtensao, extensao) == 0;
+}
+
 // ======================= FUNÇÕES DE DESENHO E ITERAÇÃO =======================
 /*
  * Função Wrapper (Callback) para iteração da Arena.
- * Converte o ponteiro genérico (void *auxData) de volta para FILE * para desenhar.
+ * Converte o ponteiro genérico (void *auxData) de volta para EscritorSvg para desenhar.
  */
 static void desenhaFormaWrapper(Forma f, void *auxData) {
-    FILE *svg = (FILE *)auxData;
+    EscritorSvg svg = (EscritorSvg)auxData;
     desenhaForma(f, svg); 
 }
 
 
-// * Desenha todas as formas no Chao (que usa uma Fila).
+// * Desenha todas as formas no Chao (que usa uma Fila), sem retirá-las da fila.
 
-static void desenhaContainerFormas(Chao chao, FILE *svg) {
+static void desenhaContainerFormas(Chao chao, EscritorSvg svg) {
     if (chao == NULL || svg == NULL) return;
 
-    int tamanhoOriginal = getChaoTamanho(chao);
-
-    for (int i = 0; i < tamanhoOriginal; i++) {
-        Forma f = removeFormaChao(chao); // 1. Desenfileira
-        if (f != NULL) {
-            desenhaForma(f, svg); // 2. Desenha
-            adicionaFormaChao(chao, f); // 3. Enfileira de volta
-        }
-    }
+    iteraFormasChao(chao, desenhaFormaWrapper, svg);
 }
 
 // =============================================================================================================
@@ -107,12 +130,28 @@ padrao c99 -> int main(int argc, char *argv[]) =
 */
 int main(int argc, char *argv[]) {
 
+    //começo da fase "linha_de_comando"; só depois dela se sabe se há --profile
+    MarcaPerfil inicioLinhaDeComando = marcaPerfil();
+
     //definicao e inicializacao das variáveis de caminhos
     char dirEntrada[PATH_LEN] = ".";
     char arqGeo[FILE_NAME_LEN] = "";
     char arqQry[FILE_NAME_LEN] = "";
     char dirSaida[PATH_LEN] = "";
 
+    //threads do calc (opcional, -t)
+    int threadsCalc = 1;
+
+    //nível de detalhe do relatório .txt (opcional, -v)
+    NivelRelatorio nivelRelatorio = RELATORIO_COMPLETO;
+
+    //arquivo JSON do perfil de execução (opcional, --profile)
+    const char *arqPerfil = NULL;
+
+    //tempos por comando do .qry (opcional, --stats) e quantas linhas lentas listar
+    const char *arqEstatisticas = NULL;
+    int numLinhasLentas = 10;
+
     //flags de parâmetros obrigatórios
     bool f_encontrado = false;
     bool o_encontrado = false;
@@ -156,16 +195,76 @@ int main(int argc, char *argv[]) {
             trataPath(dirSaida, PATH_LEN, argv[i]);
             o_encontrado = true;
         }
+        else if (strcmp(argv[i], "-t") == 0) { // Threads do calc (opcional)
+            i++;
+            if (i >= argc) {
+                fprintf(stderr, "ERRO: O parametro -t requer um numero de threads.\n");
+                return EXIT_FAILURE;
+            }
+            char *fim;
+            long valor = strtol(argv[i], &fim, 10);
+            if (fim == argv[i] || *fim != '\0' || valor < 1 || valor > 256) {
+                fprintf(stderr, "ERRO: Numero de threads invalido para -t: %s (use 1 a 256).\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            threadsCalc = (int) valor;
+        }
+        else if (strcmp(argv[i], "-v") == 0) { // Nível do relatório .txt (opcional)
+            i++;
+            if (i >= argc) {
+                fprintf(stderr, "ERRO: O parametro -v requer um nivel (none, summary, commands ou full).\n");
+                return EXIT_FAILURE;
+            }
+            if (!trataNivelRelatorio(argv[i], &nivelRelatorio)) {
+                fprintf(stderr, "ERRO: Nivel invalido para -v: %s (use none, summary, commands ou full).\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "--profile") == 0) { // Perfil de execução em JSON (opcional)
+            i++;
+            if (i >= argc) {
+                fprintf(stderr, "ERRO: O parametro --profile requer um nome de arquivo.\n");
+                return EXIT_FAILURE;
+            }
+            arqPerfil = argv[i];
+        }
+        else if (strcmp(argv[i], "--stats") == 0) { // Tempos dos comandos do .qry (opcional)
+            i++;
+            if (i >= argc) {
+                fprintf(stderr, "ERRO: O parametro --stats requer um nome de arquivo.\n");
+                return EXIT_FAILURE;
+            }
+            arqEstatisticas = argv[i];
+        }
+        else if (strcmp(argv[i], "--stats-n") == 0) { // Linhas lentas listadas em --stats (opcional)
+            i++;
+            if (i >= argc) {
+                fprintf(stderr, "ERRO: O parametro --stats-n requer um numero de linhas.\n");
+                return EXIT_FAILURE;
+            }
+            char *fim;
+            long valor = strtol(argv[i], &fim, 10);
+            if (fim == argv[i] || *fim != '\0' || valor < 0 || valor > 100000) {
+                fprintf(stderr, "ERRO: Numero de linhas invalido para --stats-n: %s (use 0 a 100000).\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            numLinhasLentas = (int) valor;
+        }
         else {
             fprintf(stderr, "AVISO: Parametro desconhecido ignorado: %s\n", argv[i]);
         }
         i++;
     }
 
+    //perfil das fases, só com --profile (NULL: as chamadas de medição não fazem nada)
+    Perfil perfil = (arqPerfil != NULL) ? criaPerfil() : NULL;
+    iniciaFasePerfilDesde(perfil, "linha_de_comando", inicioLinhaDeComando);
+
     // ======================= 2. VALIDAÇÃO E PREPARAÇÃO =======================
 
     if (!f_encontrado || !o_encontrado) {
         fprintf(stderr, "ERRO: Os parametros -f e -o sao obrigatorios. Abortando.\n");
+        destroiPerfil(perfil);
         return EXIT_FAILURE;
     }
 
@@ -174,9 +273,12 @@ int main(int argc, char *argv[]) {
 
     char *caminhoCompletoGeo = montaCaminhoCompleto(dirEntrada, arqGeo);
     if (caminhoCompletoGeo == NULL) {
+         destroiPerfil(perfil);
          return EXIT_FAILURE;
     }
 
+    encerraFasePerfil(perfil, 0, 0);
+
     // ======================= 3. ESTRUTURAS CENTRAIS E ARENA =======================
 
     Chao meuChao = NULL;
@@ -188,32 +290,44 @@ int main(int argc, char *argv[]) {
     const double ALTURA_ARENA = 810.0; //810
  
     
+    iniciaFasePerfil(perfil, "geo");
     minhaArena = criaArena(LARGURA_ARENA, ALTURA_ARENA);
     if (minhaArena == NULL) {
         fprintf(stderr, "ERRO fatal: Nao foi possivel criar a Arena.\n");
         free(caminhoCompletoGeo);
+        destroiPerfil(perfil);
         return EXIT_FAILURE;
     }
+    setArenaThreadsCalc(minhaArena, threadsCalc);
 
     // ======================= 4. PROCESSAMENTO DO ARQUIVO .GEO =======================
 
-    // processaGeo retorna o Chao, que é o repositório inicial
-    meuChao = processaGeo(caminhoCompletoGeo);
+    // processaGeo retorna o Chao, que é o repositório inicial; cenas já
+    // convertidas pelo geo2geob (.geob) são lidas sem interpretar texto
+    if (temExtensao(arqGeo, ".geob")) {
+        meuChao = processaGeob(caminhoCompletoGeo);
+    } else {
+        meuChao = processaGeo(caminhoCompletoGeo);
+    }
     
     if (meuChao == NULL) {
         fprintf(stderr, "ERRO fatal: Falha ao processar o arquivo GEO ou criar o Chao.\n");
         destroiArena(minhaArena);
         free(caminhoCompletoGeo);
+        destroiPerfil(perfil);
         return EXIT_FAILURE;
     }
 
+    encerraFasePerfil(perfil, getChaoTamanho(meuChao), getArenaNumFormas(minhaArena));
+
     // ======================= 5. GERAÇÃO DO SVG INICIAL (ESTADO DO CHÃO) =======================
+    iniciaFasePerfil(perfil, "svg_inicial");
 
     char nomeSvgInicial[MAX_FULL_PATH];
     sprintf(nomeSvgInicial, "%s.svg", nomeBaseGeo);
     char *caminhoSvgInicial = montaCaminhoCompleto(dirSaida, nomeSvgInicial);
     
-    FILE *svgInicial = inicializaSvg(caminhoSvgInicial, LARGURA_ARENA, ALTURA_ARENA);
+    EscritorSvg svgInicial = inicializaSvg(caminhoSvgInicial, LARGURA_ARENA, ALTURA_ARENA);
     
     if (svgInicial != NULL) {
         desenhaContainerFormas(meuChao, svgInicial);
@@ -222,6 +336,7 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "AVISO: Nao foi possivel criar o SVG inicial em %s\n", caminhoSvgInicial);
     }
     free(caminhoSvgInicial);
+    encerraFasePerfil(perfil, getChaoTamanho(meuChao), getArenaNumFormas(minhaArena));
 
 
 // ======================= 6. PROCESSAMENTO DO ARQUIVO .QRY  =======================
@@ -246,17 +361,35 @@ if (arqQry[0] != '\0') {
     char *caminhoTxtQry = montaCaminhoCompleto(dirSaida, nomeTxtQry);
     
     // Chamada principal para processar o QRY
+    EstatisticasQry estatisticas = NULL;
+    if (arqEstatisticas != NULL) {
+        estatisticas = criaEstatisticasQry(numLinhasLentas);
+    }
+    iniciaFasePerfil(perfil, "qry");
 processaQry(caminhoCompletoQry, caminhoTxtQry, minhaArena, meuChao, 
-            &pontuacaoTotal, &formas_clonadas, &formas_esmagadas);
+            &pontuacaoTotal, &formas_clonadas, &formas_esmagadas, nivelRelatorio, estatisticas);
+    encerraFasePerfil(perfil, getChaoTamanho(meuChao), getArenaNumFormas(minhaArena));
+
+    if (estatisticas != NULL) {
+        FILE *arquivoEstatisticas = fopen(arqEstatisticas, "w");
+        if (arquivoEstatisticas != NULL) {
+            escreveEstatisticasQry(estatisticas, arquivoEstatisticas);
+            fclose(arquivoEstatisticas);
+        } else {
+            fprintf(stderr, "AVISO: Nao foi possivel criar as estatisticas em %s\n", arqEstatisticas);
+        }
+        destroiEstatisticasQry(estatisticas);
+    }
 
 
 
 //Geração do SVG Final
+    iniciaFasePerfil(perfil, "svg_final");
     char nomeSvgFinal[MAX_FULL_PATH];
     snprintf(nomeSvgFinal, sizeof(nomeSvgFinal), "%s.svg", nomeSaidaBaseQry);
     char *caminhoSvgFinal = montaCaminhoCompleto(dirSaida, nomeSvgFinal);
 
-    FILE *svgFinal = inicializaSvg(caminhoSvgFinal, LARGURA_ARENA, ALTURA_ARENA);
+    EscritorSvg svgFinal = inicializaSvg(caminhoSvgFinal, LARGURA_ARENA, ALTURA_ARENA);
 
 if (svgFinal != NULL) {
 
@@ -269,13 +402,32 @@ if (svgFinal != NULL) {
 } else {
     fprintf(stderr, "AVISO: Nao foi possivel criar o SVG final em %s\n", caminhoSvgFinal);
 }
+    encerraFasePerfil(perfil, getChaoTamanho(meuChao), getArenaNumFormas(minhaArena));
 }
 
 
     // ======================= 7. LIBERAÇÃO DE MEMÓRIA =======================    
-    destroiArena(minhaArena); 
-    destroiChao(meuChao); 
+    iniciaFasePerfil(perfil, "liberacao");
+    //as células das formas saem todas juntas em liberaTodaMemoriaFormas;
+    //antes, só os textos liberam o que têm fora da célula
+    descartaArena(minhaArena);
+    descartaChao(meuChao);
+    liberaTodaMemoriaFormas(); //devolve os blocos de formas de uma vez
+    liberaTabelaEstilos();
+    liberaTabelaCores();
     free(caminhoCompletoGeo);
+    encerraFasePerfil(perfil, 0, 0);
+
+    if (arqPerfil != NULL) {
+        registraValorPerfil(perfil, "threads_calc", threadsCalc);
+        registraValorPerfil(perfil, "nivel_relatorio", nivelRelatorio);
+        registraValorPerfil(perfil, "formas_esmagadas", formas_esmagadas);
+        registraValorPerfil(perfil, "formas_clonadas", formas_clonadas);
+        if (!escrevePerfil(perfil, arqPerfil)) {
+            fprintf(stderr, "AVISO: Nao foi possivel criar o perfil em %s\n", arqPerfil);
+        }
+    }
+    destroiPerfil(perfil);
     
     return EXIT_SUCCESS; 
 }
\ No newline at end of file